@@ -4,50 +4,26 @@
 #
 #-------------------------------------------------
 
-QT       += core gui
-
-greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
-
-TARGET = WaterWorld
-TEMPLATE = app
-
-CONFIG += console
-CONFIG += c++11
-
-
-SOURCES += main.cpp\
-        mainwindow.cpp \
-    universescene.cpp \
-    minimapview.cpp \
-    universeview.cpp \
-    universe.cpp \
-    waterobject.cpp \
-    isle.cpp \
-    ship.cpp \
-    shiplistitem.cpp \
-    overviewdialog.cpp \
-    graphicspathitem.cpp \
-    pathlistitem.cpp \
-    computerplayer.cpp \
-    player.cpp \
-    waterobjectinfo.cpp
-
-HEADERS  += mainwindow.h \
-    universescene.h \
-    minimapview.h \
-    universeview.h \
-    universe.h \
-    waterobject.h \
-    isle.h \
-    ship.h \
-    shiplistitem.h \
-    overviewdialog.h \
-    graphicspathitem.h \
-    pathlistitem.h \
-    computerplayer.h \
-    player.h \
-    waterobjectinfo.h
-
-FORMS    += mainwindow.ui \
-    waterobjectinfo.ui \
-    overviewdialog.ui
+# waterworld_core:     simulation (Universe, Isle, Ship, Player, ComputerPlayer), QtCore only
+# waterworld_app:      the WaterWorld GUI, renders the universe
+# waterworld_bench:    turn-time benchmark, prints JSON
+# waterworld_eventlog: prints a binary event log as text
+# waterworld_stats:    converts the per round statistics to CSV
+
+TEMPLATE = subdirs
+
+SUBDIRS += waterworld_core \
+    waterworld_app \
+    waterworld_bench \
+    waterworld_eventlog \
+    waterworld_stats
+
+waterworld_core.file = waterworld_core.pro
+waterworld_app.file = waterworld_app.pro
+waterworld_app.depends = waterworld_core
+waterworld_bench.file = waterworld_bench.pro
+waterworld_bench.depends = waterworld_core
+waterworld_eventlog.file = waterworld_eventlog.pro
+waterworld_eventlog.depends = waterworld_core
+waterworld_stats.file = waterworld_stats.pro
+waterworld_stats.depends = waterworld_core
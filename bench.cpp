@@ -0,0 +1,213 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+/* waterworld_bench: runs seeded universes over a grid of sizes without any GUI
+ * and reports how long Universe::nextRound() and its phases take, as JSON.
+ * Each combination of isles and enemies runs up to the biggest number of turns,
+ * the other turn numbers are checkpoints on the way. */
+
+
+#include <universe.h>
+#include <roundprofile.h>
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStringList>
+#include <QVector>
+#include <algorithm>
+#include <math.h>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+
+// peak resident set size of this process in kB, 0 if unknown
+static qint64 peakRssKb()
+{
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if(GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return (qint64) counters.PeakWorkingSetSize / 1024;
+    return 0;
+#else
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#if defined(Q_OS_MACOS) || defined(Q_OS_OSX)
+    return (qint64) usage.ru_maxrss / 1024;     // bytes
+#else
+    return (qint64) usage.ru_maxrss;            // kB
+#endif
+#endif
+}
+
+
+// the simulation talks a lot, we only want warnings and worse
+static void quietMessageHandler(QtMsgType inType, const QMessageLogContext &, const QString & inMessage)
+{
+    if(inType == QtDebugMsg or inType == QtInfoMsg)
+        return;
+    fprintf(stderr, "%s\n", qPrintable(inMessage));
+}
+
+
+// "20,100,1000" -> sorted list of numbers, empty on error
+static QVector<uint> parseList(const QString & inList)
+{
+    QVector<uint> outValues;
+    for(const QString & part : inList.split(',', QString::SkipEmptyParts))
+    {
+        bool ok = false;
+        uint value = part.trimmed().toUInt(&ok);
+        if(! ok or value == 0)
+            return QVector<uint>();
+        outValues.append(value);
+    }
+    std::sort(outValues.begin(), outValues.end());
+    return outValues;
+}
+
+
+static QJsonObject runScenario(const uint inNumIsles, const uint inNumEnemies,
+                               const QVector<uint> & inTurnCheckpoints, const quint64 inSeed)
+{
+    // keep the density of the GUI universe (20 isles on 1000 x 1000) or lower
+    const qreal side = qMax(1000.0, ceil(sqrt((double) inNumIsles)) * 100.0);
+
+    QElapsedTimer timer;
+    timer.start();
+    Universe universe(0, side, side, inNumIsles, inNumEnemies, inSeed);
+    const qint64 createNs = timer.nsecsElapsed();
+
+    qint64 totalNs = 0;
+    qint64 shipTurns = 0;   // sum of ships over all turns, for ns/ship
+    qint64 phaseNs[RoundProfile::PH_COUNT] = {0};
+    qint64 counters[RoundProfile::CT_COUNT] = {0};
+
+    QJsonArray checkpoints;
+    uint turn = 0;
+    for(uint checkpoint : inTurnCheckpoints)
+    {
+        for(; turn < checkpoint; turn++)
+        {
+            timer.restart();
+            universe.nextRound();
+            totalNs += timer.nsecsElapsed();
+            shipTurns += universe.ships().count();
+            const RoundProfile & profile = universe.lastRoundProfile();
+            for(int phase = 0; phase < RoundProfile::PH_COUNT; phase++)
+                phaseNs[phase] += profile.phaseNs[phase];
+            for(int counter = 0; counter < RoundProfile::CT_COUNT; counter++)
+                counters[counter] += profile.counters[counter];
+        }
+
+        QJsonObject phases;
+        for(int phase = 0; phase < RoundProfile::PH_COUNT; phase++)
+            phases.insert(RoundProfile::phaseName((RoundProfile::PhaseEnum) phase),
+                          (double) phaseNs[phase] / turn);
+        QJsonObject counts;
+        for(int counter = 0; counter < RoundProfile::CT_COUNT; counter++)
+            counts.insert(RoundProfile::counterName((RoundProfile::CounterEnum) counter),
+                          (double) counters[counter] / turn);
+
+        QJsonObject result;
+        result.insert("turns", (int) turn);
+        result.insert("ships", universe.ships().count());
+        result.insert("ns_per_turn", (double) totalNs / turn);
+        result.insert("ns_per_ship", shipTurns > 0 ? (double) totalNs / shipTurns : 0.0);
+        result.insert("phase_ns_per_turn", phases);
+        result.insert("counts_per_turn", counts);
+        result.insert("peak_rss_kb", (double) peakRssKb());
+        checkpoints.append(result);
+    }
+
+    QJsonObject outScenario;
+    outScenario.insert("isles", (int) inNumIsles);
+    outScenario.insert("enemies", (int) inNumEnemies);
+    outScenario.insert("universe_size", side);
+    outScenario.insert("create_ns", (double) createNs);
+    outScenario.insert("checkpoints", checkpoints);
+    return outScenario;
+}
+
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("waterworld_bench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Times Universe::nextRound() over a grid of universe sizes and prints JSON.");
+    parser.addHelpOption();
+    QCommandLineOption islesOption("isles", "Comma separated numbers of isles.", "list", "20,100,1000,10000,100000");
+    QCommandLineOption enemiesOption("enemies", "Comma separated numbers of computer players.", "list", "1,4,16,64");
+    QCommandLineOption turnsOption("turns", "Comma separated turn checkpoints, each scenario runs up to the biggest.", "list", "1,100,10000");
+    QCommandLineOption seedOption("seed", "Seed for every universe.", "n", "1");
+    QCommandLineOption outputOption("output", "Write the JSON report to <file> instead of stdout.", "file");
+    parser.addOption(islesOption);
+    parser.addOption(enemiesOption);
+    parser.addOption(turnsOption);
+    parser.addOption(seedOption);
+    parser.addOption(outputOption);
+    parser.process(app);
+
+    QVector<uint> isles = parseList(parser.value(islesOption));
+    QVector<uint> enemies = parseList(parser.value(enemiesOption));
+    QVector<uint> turns = parseList(parser.value(turnsOption));
+    bool seedOk = false;
+    quint64 seed = parser.value(seedOption).toULongLong(&seedOk);
+    if(isles.isEmpty() or enemies.isEmpty() or turns.isEmpty() or not seedOk)
+        parser.showHelp(1);
+
+    qInstallMessageHandler(quietMessageHandler);
+
+    QJsonArray scenarios;
+    for(uint numIsles : isles)
+        for(uint numEnemies : enemies)
+        {
+            // every player needs an isle of its own, the human gets the first one
+            if(numEnemies >= numIsles)
+            {
+                fprintf(stderr, "isles %u, enemies %u: skipped, needs more isles than enemies\n",
+                        numIsles, numEnemies);
+                continue;
+            }
+            fprintf(stderr, "isles %u, enemies %u ...\n", numIsles, numEnemies);
+            scenarios.append(runScenario(numIsles, numEnemies, turns, seed));
+        }
+
+    QJsonObject report;
+    report.insert("seed", QString::number(seed));
+    report.insert("profile_compiled_in", RoundProfile::compiledIn());
+    // peak RSS is per process, so later scenarios include earlier ones.
+    // Run one scenario per process to get separate numbers.
+    report.insert("peak_rss_kb", (double) peakRssKb());
+    report.insert("scenarios", scenarios);
+    QByteArray json = QJsonDocument(report).toJson();
+
+    if(parser.isSet(outputOption))
+    {
+        QFile file(parser.value(outputOption));
+        if(! file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            fprintf(stderr, "cannot write %s\n", qPrintable(parser.value(outputOption)));
+            return 1;
+        }
+        file.write(json);
+    }
+    else
+        fwrite(json.constData(), 1, json.size(), stdout);
+    return 0;
+}
@@ -0,0 +1,31 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+#include <changefeed.h>
+
+#include <algorithm>
+
+
+void ChangeFeed::shipDestroyed(const uint inShipId)
+{
+    m_changedShips.remove(inShipId);
+    m_destroyedShips.insert(inShipId);
+}
+
+
+void ChangeFeed::take(QList<uint> & outChangedIsles, QList<uint> & outChangedShips, QList<uint> & outDestroyedShips)
+{
+    outChangedIsles = m_changedIsles.toList();
+    outChangedShips = m_changedShips.toList();
+    outDestroyedShips = m_destroyedShips.toList();
+    // ids grow with creation, so this is the order of Universe::m_isles and m_ships
+    std::sort(outChangedIsles.begin(), outChangedIsles.end());
+    std::sort(outChangedShips.begin(), outChangedShips.end());
+    std::sort(outDestroyedShips.begin(), outDestroyedShips.end());
+    m_changedIsles.clear();
+    m_changedShips.clear();
+    m_destroyedShips.clear();
+}
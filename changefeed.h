@@ -0,0 +1,44 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+#ifndef CHANGEFEED_H
+#define CHANGEFEED_H
+
+
+#include <QList>
+#include <QSet>
+
+
+/**
+ * @brief The ChangeFeed class records, which isles and ships changed since the last take()
+ *
+ * Isles and ships report themselves, whenever they get created or change owner, position,
+ * targets, damage or anything else visible in their info(). Deleted ships are reported
+ * separately. Universe takes the feed once per round to send only these objects to
+ * the computer players, see Universe::prepareStrategies().
+ */
+class ChangeFeed
+{
+public:
+    void isleChanged(const uint inIsleId) { m_changedIsles.insert(inIsleId); }
+
+    void shipChanged(const uint inShipId) { m_changedShips.insert(inShipId); }
+
+    void shipDestroyed(const uint inShipId);
+
+    /**
+     * @brief take - hands out all ids (sorted) recorded so far and starts a new recording
+     * @param outDestroyedShips - ships, which are gone. They are not part of outChangedShips.
+     */
+    void take(QList<uint> & outChangedIsles, QList<uint> & outChangedShips, QList<uint> & outDestroyedShips);
+
+private:
+    QSet<uint> m_changedIsles;
+    QSet<uint> m_changedShips;
+    QSet<uint> m_destroyedShips;
+};
+
+#endif // CHANGEFEED_H
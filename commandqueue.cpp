@@ -0,0 +1,52 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+#include <commandqueue.h>
+
+
+static int roundUpToPowerOf2(const int inValue)
+{
+    int value = 2;
+    while(value < inValue)
+        value *= 2;
+    return value;
+}
+
+
+CommandQueue::CommandQueue(const int inCapacity)
+    : m_slots(roundUpToPowerOf2(inCapacity)), m_mask(m_slots.count() - 1), m_head(0), m_tail(0)
+{
+}
+
+
+bool CommandQueue::push(const ComputerMove & inMove)
+{
+    const int tail = m_tail.load();
+    const int next = (tail + 1) & m_mask;
+    // the consumer frees slots by moving m_head, acquire makes its reads happen before our write
+    if(next == m_head.loadAcquire())
+        return false;
+    m_slots[tail] = inMove;
+    // publish the slot
+    m_tail.storeRelease(next);
+    return true;
+}
+
+
+int CommandQueue::take(QList<ComputerMove> & outMoves)
+{
+    int head = m_head.load();
+    const int tail = m_tail.loadAcquire();
+    int taken = 0;
+    while(head != tail)
+    {
+        outMoves.append(m_slots.at(head));
+        head = (head + 1) & m_mask;
+        taken++;
+    }
+    m_head.storeRelease(head);
+    return taken;
+}
@@ -0,0 +1,51 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+#ifndef COMMANDQUEUE_H
+#define COMMANDQUEUE_H
+
+
+#include <computerplayer.h>
+
+#include <QAtomicInt>
+#include <QList>
+#include <QVector>
+
+
+/**
+ * @brief The CommandQueue class carries moves from one thread to another, without locks
+ *
+ * Exactly one thread may push() (the GUI) and exactly one thread may take() (the
+ * simulation). Neither side ever waits for the other. The queue has a fixed size,
+ * push() fails if the consumer falls that far behind.
+ */
+class CommandQueue
+{
+public:
+    // inCapacity is rounded up to a power of 2. One slot is always kept free
+    explicit CommandQueue(const int inCapacity = 1024);
+
+    // producer side. false, if the queue is full and the move was dropped
+    bool push(const ComputerMove & inMove);
+
+    // consumer side. Appends all waiting moves to outMoves in order of push(),
+    // returns the number of moves taken
+    int take(QList<ComputerMove> & outMoves);
+
+    // a hint only, the other side may change it at any time
+    bool isEmpty() const { return m_head.loadAcquire() == m_tail.loadAcquire(); }
+
+private:
+    Q_DISABLE_COPY(CommandQueue)
+
+    QVector<ComputerMove> m_slots;
+    const int m_mask;
+
+    QAtomicInt m_head;  // next slot to take, written by the consumer only
+    QAtomicInt m_tail;  // next slot to fill, written by the producer only
+};
+
+#endif // COMMANDQUEUE_H
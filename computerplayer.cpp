@@ -5,6 +5,7 @@
 
 
 #include <computerplayer.h>
+#include <tracerecorder.h>
 
 #include <QPair>
 #include <QSet>
@@ -18,10 +19,48 @@ ComputerPlayer::ComputerPlayer(const uint inOwner)
 }
 
 
-void ComputerPlayer::setIsles(const QList<IsleInfo> inPublicIsleInfos, const QList<IsleInfo> inPrivateIsleInfos)
+void ComputerPlayer::applyDelta(const WorldDelta & inDelta)
 {
-    m_publicIsles = inPublicIsleInfos;
-    m_privateIsles = inPrivateIsleInfos;
+    for(const ExtendedShipInfo & esi : inDelta.ships)
+    {
+        uint shipId = esi.shipInfo.id;
+        if(esi.shipInfo.owner == owner())
+        {
+            m_privateShips.insert(shipId, esi);
+            m_publicShips.remove(shipId);
+        }
+        else
+        {
+            m_privateShips.remove(shipId);
+            if(esi.shipInfo.posType == ShipPositionEnum::SP_OCEAN)
+                // just keep, if visible to everyone
+                m_publicShips.insert(shipId, esi.shipInfo);
+            else
+                m_publicShips.remove(shipId);
+        }
+    }
+    for(uint shipId : inDelta.destroyedShips)
+    {
+        m_privateShips.remove(shipId);
+        m_publicShips.remove(shipId);
+    }
+
+    if(inDelta.isles.isEmpty())
+        return;
+
+    for(const IsleInfo & isleInfo : inDelta.isles)
+    {
+        if(isleInfo.owner == owner())
+        {
+            m_privateIsles.insert(isleInfo.id, isleInfo);
+            m_publicIsles.remove(isleInfo.id);
+        }
+        else
+        {
+            m_publicIsles.insert(isleInfo.id, isleInfo);
+            m_privateIsles.remove(isleInfo.id);
+        }
+    }
 
     // test for unowned isles
     m_thereAreUnownedIsles = false;
@@ -42,20 +81,14 @@ void ComputerPlayer::setIsles(const QList<IsleInfo> inPublicIsleInfos, const QLi
     // @fixme: we should do this once at start, not each time we call this method (every turn)
     if(m_homeIsleId == 0 and m_privateIsles.count() == 1)
     {
-        m_homeIsleId = m_privateIsles.at(0).id;
+        m_homeIsleId = m_privateIsles.first().id;
     }
 }
 
 
-void ComputerPlayer::setShips(const QList<ShipInfo> inPublicShipInfos, const QList<ExtendedShipInfo> inPrivateShipInfos)
-{
-    m_publicShips = inPublicShipInfos;
-    m_privateShips = inPrivateShipInfos;
-}
-
-
 void ComputerPlayer::nextRound(QList<ComputerMove> & outMoves)
 {
+    WW_TRACE_SPAN_ARG("ComputerPlayer::nextRound", "owner", owner());
     uint numMyIsles = m_privateIsles.count();
 
     if(numMyIsles == 0)
@@ -93,7 +126,7 @@ void ComputerPlayer::nextRound(QList<ComputerMove> & outMoves)
         // every new colony ship should now get a target
         if(unownedIsles.count() > 0)
         {
-            IsleInfo isleInfo = m_privateIsles.at(0);
+            IsleInfo isleInfo = m_privateIsles.first();
             // make sure, we build colony ships
             if(isleInfo.shipToBuild != ShipTypeEnum::ST_COLONY)
             {
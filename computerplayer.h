@@ -11,8 +11,8 @@
 #include <player.h>
 #include <isle.h>
 #include <ship.h>
-#include <QColor>
 #include <QList>
+#include <QMap>
 #include <QPair>
 
 
@@ -23,20 +23,44 @@ struct ExtendedShipInfo
 };
 
 
+/* Everything, which changed since the last round. Universe builds this
+ * once per round from its ChangeFeed and sends it to every computer player */
+struct WorldDelta
+{
+    QList<IsleInfo> isles;          // new and changed isles
+    QList<ExtendedShipInfo> ships;  // new and changed ships, of every owner
+    QList<uint> destroyedShips;
+};
+
+
+/* One order of a player, computer or human. Universe checks every move
+ * before it is applied, see Universe::processStrategyCommands() */
 struct ComputerMove
 {
-    // @fixme: "add to fleet" and "multitargets" (repeatable) are missing
     enum MoveTypeEnum { MT_ISLE_BUILD_SHIPTYPE,
                         MT_ISLE_ALL_SHIPS_TO_PATROL,
                         MT_SHIP_SET_TARGET_IMMEDIATELY, // clear targets, then set target
                         MT_SHIP_SET_TARGET,             // set target
-                        MT_SHIP_SET_PATROL};
+                        MT_SHIP_SET_PATROL,
+                        MT_SHIP_DELETE,                 // scrap a ship, which is on an isle
+                        MT_SHIP_TOGGLE_PATROL,          // ship on isle <-> ship patrols isle
+                        MT_SHIP_REMOVE_TARGETS,         // index < 0: all targets, else the one with index
+                        MT_SHIP_SET_CYCLE_TARGETS,      // index != 0: repeat the targets
+                        MT_SHIP_ADD_TO_FLEET,           // targetId is the fleet, 0 for a new one
+                        MT_SHIP_PICK_TARGET,            // target is, whatever is found at pos
+                        MT_ISLE_PICK_DEFAULT_TARGET,    // isle or water at pos, the isle itself removes it
+                        MT_ISLE_REMOVE_DEFAULT_TARGET};
     MoveTypeEnum moveType;
     ShipTypeEnum shipTypeToBuild;   // sourceId must build this shiptype
     uint sourceId;  // ship or isle, the waterobject we talk about
     Target::TargetEnum targetType;
     uint targetId;      //  for ship or isle target, target isle if ship goes patrol
     QPointF pos;        // for water target
+    int index;          // target index or cycle flag
+
+    ComputerMove()
+        : moveType(MT_ISLE_BUILD_SHIPTYPE), shipTypeToBuild(ShipTypeEnum::ST_BATTLESHIP), sourceId(0),
+          targetType(Target::T_WATER), targetId(0), index(0) {}
 };
 
 
@@ -46,18 +70,11 @@ public:
     ComputerPlayer(uint inOwner);
 
     /**
-     * @brief setIsles
-     * @param inPublicIsleInfos - list with islesInfos, not owned by m_owner
-     * @param inPrivateIsleInfos - list with islesInfos, owned by m_owner
-     */
-    void setIsles(const QList<IsleInfo> inPublicIsleInfos, const QList<IsleInfo> inPrivateIsleInfos);
-
-    /**
-     * @brief setShips
-     * @param inPublicShipInfos - list of public visible enemy ships (ShipPositionEnum::S_OCEAN)
-     * @param inPrivateShipInfos - list of own ships
+     * @brief applyDelta - brings our view of the world up to date
+     * @param inDelta - changes since the last call. Enemy ships are only kept,
+     *                  if they are public visible (ShipPositionEnum::SP_OCEAN)
      */
-    void setShips(const QList<ShipInfo> inPublicShipInfos, const QList<ExtendedShipInfo> inPrivateShipInfos);
+    void applyDelta(const WorldDelta & inDelta);
 
     /**
      * @brief nextRound - processes the strategy and returns a list of moves to the caller
@@ -92,13 +109,14 @@ protected:
 
     void closestHomeIsleFromEnemyIsle(const uint inEnemyIsleId, IsleInfo & outHomeIsleInfo);
 
-    QList<IsleInfo> m_publicIsles;
-    QList<IsleInfo> m_privateIsles;
+    // our view of the world, by id, see applyDelta()
+    QMap<uint, IsleInfo> m_publicIsles;     // isles not owned by us
+    QMap<uint, IsleInfo> m_privateIsles;    // isles owned by us
 
     uint m_homeIsleId;
 
-    QList<ShipInfo> m_publicShips;
-    QList<ExtendedShipInfo> m_privateShips;
+    QMap<uint, ShipInfo> m_publicShips;             // enemy ships on the ocean
+    QMap<uint, ExtendedShipInfo> m_privateShips;    // own ships
 
     bool m_thereAreUnownedIsles;
     QPointF m_centerOfMyIsles;
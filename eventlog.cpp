@@ -0,0 +1,170 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+#include <eventlog.h>
+
+#include <QFile>
+#include <QDataStream>
+#include <QStringList>
+
+
+namespace
+{
+    const quint32 EVENTLOG_MAGIC = 0x57574556;     // "WWEV"
+    const quint32 EVENTLOG_VERSION = 1;
+}
+
+
+EventLog::EventLog(const int inCapacity)
+    : m_capacity(inCapacity), m_categories(CAT_NONE), m_round(0), m_next(0), m_count(0)
+{
+    Q_ASSERT(inCapacity > 0);
+}
+
+
+void EventLog::setCategories(const uint inCategories)
+{
+    m_categories = inCategories & CAT_ALL;
+    if(m_categories != CAT_NONE and m_buffer.isEmpty())
+        m_buffer.resize(m_capacity);
+}
+
+
+void EventLog::append(const EventTypeEnum inType, const uint inSub, const uint inA, const uint inB,
+                      const uint inC, const float inValue)
+{
+    Q_ASSERT(not m_buffer.isEmpty());
+    EventRecord & r = m_buffer[m_next];
+    r.round = m_round;
+    r.type = (quint16) inType;
+    r.sub = (quint16) inSub;
+    r.a = inA;
+    r.b = inB;
+    r.c = inC;
+    r.value = inValue;
+    m_next = (m_next + 1) % m_capacity;
+    if(m_count < m_capacity)
+        m_count++;
+}
+
+
+QVector<EventRecord> EventLog::records() const
+{
+    QVector<EventRecord> out;
+    out.reserve(m_count);
+    // the oldest record is m_count slots behind m_next
+    int index = (m_next - m_count + m_capacity) % m_capacity;
+    for(int i = 0; i < m_count; i++)
+    {
+        out.append(m_buffer.at(index));
+        index = (index + 1) % m_capacity;
+    }
+    return out;
+}
+
+
+bool EventLog::save(const QString & inFileName) const
+{
+    QFile file(inFileName);
+    if(! file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+    QDataStream out(&file);
+    out.setByteOrder(QDataStream::LittleEndian);
+    out.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    out << EVENTLOG_MAGIC << EVENTLOG_VERSION << (quint32) m_count;
+    for(const EventRecord & r : records())
+        out << r.round << r.type << r.sub << r.a << r.b << r.c << r.value;
+    return out.status() == QDataStream::Ok;
+}
+
+
+bool EventLog::load(const QString & inFileName, QVector<EventRecord> & outRecords)
+{
+    outRecords.clear();
+    QFile file(inFileName);
+    if(! file.open(QIODevice::ReadOnly))
+        return false;
+    QDataStream in(&file);
+    in.setByteOrder(QDataStream::LittleEndian);
+    in.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    quint32 magic, version, count;
+    in >> magic >> version >> count;
+    if(in.status() != QDataStream::Ok or magic != EVENTLOG_MAGIC or version != EVENTLOG_VERSION)
+        return false;
+    outRecords.reserve(count);
+    for(quint32 i = 0; i < count; i++)
+    {
+        EventRecord r;
+        in >> r.round >> r.type >> r.sub >> r.a >> r.b >> r.c >> r.value;
+        if(in.status() != QDataStream::Ok)
+            return false;
+        outRecords.append(r);
+    }
+    return true;
+}
+
+
+EventLog::CategoryEnum EventLog::categoryOf(const EventTypeEnum inType)
+{
+    switch(inType)
+    {
+        case EV_COMMAND_ACCEPTED:
+        case EV_COMMAND_REJECTED: return CAT_COMMANDS;
+        case EV_FIGHT_SHIP:
+        case EV_FIGHT_ISLE: return CAT_FIGHTS;
+        case EV_SHIP_DELETED: return CAT_TRASH;
+        default: return CAT_NONE;
+    }
+}
+
+
+const char* EventLog::typeName(const EventTypeEnum inType)
+{
+    switch(inType)
+    {
+        case EV_COMMAND_ACCEPTED: return "command_accepted";
+        case EV_COMMAND_REJECTED: return "command_rejected";
+        case EV_FIGHT_SHIP: return "fight_ship";
+        case EV_FIGHT_ISLE: return "fight_isle";
+        case EV_SHIP_DELETED: return "ship_deleted";
+        default: return "unknown";
+    }
+}
+
+
+const char* EventLog::categoryName(const CategoryEnum inCategory)
+{
+    switch(inCategory)
+    {
+        case CAT_COMMANDS: return "commands";
+        case CAT_FIGHTS: return "fights";
+        case CAT_TRASH: return "trash";
+        case CAT_ALL: return "all";
+        default: return "none";
+    }
+}
+
+
+bool EventLog::parseCategories(const QString & inList, uint & outCategories)
+{
+    outCategories = CAT_NONE;
+    const CategoryEnum known[] = {CAT_COMMANDS, CAT_FIGHTS, CAT_TRASH, CAT_ALL};
+    for(const QString & name : inList.split(',', QString::SkipEmptyParts))
+    {
+        bool found = false;
+        for(CategoryEnum category : known)
+        {
+            if(name.trimmed() == categoryName(category))
+            {
+                outCategories |= category;
+                found = true;
+            }
+        }
+        if(! found)
+            return false;
+    }
+    return true;
+}
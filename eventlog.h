@@ -0,0 +1,114 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+#ifndef EVENTLOG_H
+#define EVENTLOG_H
+
+
+#include <QtGlobal>
+#include <QVector>
+#include <QString>
+
+
+/**
+ * @brief The EventRecord struct is one fixed size entry of the EventLog
+ *
+ * The meaning of sub, a, b, c and value depends on type, see EventLog::EventTypeEnum.
+ */
+struct EventRecord
+{
+    quint32 round;
+    quint16 type;
+    quint16 sub;
+    quint32 a;
+    quint32 b;
+    quint32 c;
+    float value;
+};
+
+
+/**
+ * @brief The EventLog class keeps the last events of the simulation in a ring buffer
+ *
+ * Recording is cheap: no strings, just a copy of an EventRecord. Whoever wants to read
+ * the log saves it to a file and decodes it offline, see eventlogdump.cpp.
+ *
+ * Categories can be switched off at runtime with setCategories(), which is the default,
+ * or at compile time with WATERWORLD_EVENTLOG_CATEGORIES. Disabled WW_LOG_EVENT()s cost
+ * one test at runtime and nothing at compile time.
+ */
+class EventLog
+{
+public:
+    enum CategoryEnum { CAT_NONE = 0,
+                        CAT_COMMANDS = 1,   // computer player moves
+                        CAT_FIGHTS = 2,     // ship vs. ship, ship vs. isle
+                        CAT_TRASH = 4,      // ships removed from the universe
+                        CAT_ALL = 7 };
+
+    enum EventTypeEnum { EV_COMMAND_ACCEPTED = 0,   // sub: move type, a: owner, b: source id, c: target id or ship type
+                         EV_COMMAND_REJECTED,       // like EV_COMMAND_ACCEPTED
+                         EV_FIGHT_SHIP,             // sub: result, a: attacker, b: defender ship, c: attacker owner, value: attacker force
+                         EV_FIGHT_ISLE,             // sub: result, a: attacker, b: isle, c: attacker owner, value: attacker force
+                         EV_SHIP_DELETED,           // a: ship, b: owner, c: ship type, value: damage
+                         EV_COUNT };
+
+    enum FightResultEnum { FR_ATTACKER_WON = 0, FR_DEFENDER_WON, FR_BOTH_DIED };
+
+    explicit EventLog(const int inCapacity = 65536);
+
+    // bitmask of CategoryEnum, no buffer is allocated until a category gets enabled
+    void setCategories(const uint inCategories);
+    uint categories() const { return m_categories; }
+    bool isEnabled(const CategoryEnum inCategory) const { return m_categories & inCategory; }
+
+    // the round number written into each following record
+    void setRound(const uint inRound) { m_round = inRound; }
+
+    void append(const EventTypeEnum inType, const uint inSub, const uint inA, const uint inB,
+                const uint inC, const float inValue);
+
+    // number of records held, at most the capacity
+    int count() const { return m_count; }
+
+    // all records held, oldest first
+    QVector<EventRecord> records() const;
+
+    void clear() { m_next = 0; m_count = 0; }
+
+    // binary file: magic, version, number of records, records
+    bool save(const QString & inFileName) const;
+    static bool load(const QString & inFileName, QVector<EventRecord> & outRecords);
+
+    static CategoryEnum categoryOf(const EventTypeEnum inType);
+    static const char* typeName(const EventTypeEnum inType);
+    static const char* categoryName(const CategoryEnum inCategory);
+
+    // "commands,fights" -> CAT_COMMANDS | CAT_FIGHTS, "all" for everything. false on unknown names
+    static bool parseCategories(const QString & inList, uint & outCategories);
+
+private:
+    const int m_capacity;
+    uint m_categories;
+    uint m_round;
+    QVector<EventRecord> m_buffer;
+    int m_next;     // next slot to write
+    int m_count;
+};
+
+
+#ifndef WATERWORLD_EVENTLOG_CATEGORIES
+#define WATERWORLD_EVENTLOG_CATEGORIES EventLog::CAT_ALL
+#endif
+
+// record an event of a category, if enabled at compile time and at runtime
+#define WW_LOG_EVENT(log, category, type, sub, a, b, c, value) \
+    do { \
+        if((WATERWORLD_EVENTLOG_CATEGORIES & EventLog::category) and (log).isEnabled(EventLog::category)) \
+            (log).append(EventLog::type, (sub), (a), (b), (c), (value)); \
+    } while(0)
+
+#endif // EVENTLOG_H
@@ -0,0 +1,123 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+/* waterworld_eventlog: decodes a binary event log, written by EventLog::save()
+ * (see "WaterWorld --event-log"), into one text line per event. */
+
+
+#include <eventlog.h>
+#include <computerplayer.h>
+#include <ship.h>
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QStringList>
+#include <stdio.h>
+
+
+static const char* moveTypeName(const uint inMoveType)
+{
+    switch(inMoveType)
+    {
+        case ComputerMove::MT_ISLE_BUILD_SHIPTYPE: return "isle_build_shiptype";
+        case ComputerMove::MT_ISLE_ALL_SHIPS_TO_PATROL: return "isle_all_ships_to_patrol";
+        case ComputerMove::MT_SHIP_SET_TARGET_IMMEDIATELY: return "ship_set_target_immediately";
+        case ComputerMove::MT_SHIP_SET_TARGET: return "ship_set_target";
+        case ComputerMove::MT_SHIP_SET_PATROL: return "ship_set_patrol";
+        case ComputerMove::MT_SHIP_DELETE: return "ship_delete";
+        case ComputerMove::MT_SHIP_TOGGLE_PATROL: return "ship_toggle_patrol";
+        case ComputerMove::MT_SHIP_REMOVE_TARGETS: return "ship_remove_targets";
+        case ComputerMove::MT_SHIP_SET_CYCLE_TARGETS: return "ship_set_cycle_targets";
+        case ComputerMove::MT_SHIP_ADD_TO_FLEET: return "ship_add_to_fleet";
+        case ComputerMove::MT_SHIP_PICK_TARGET: return "ship_pick_target";
+        case ComputerMove::MT_ISLE_PICK_DEFAULT_TARGET: return "isle_pick_default_target";
+        case ComputerMove::MT_ISLE_REMOVE_DEFAULT_TARGET: return "isle_remove_default_target";
+        default: return "unknown";
+    }
+}
+
+
+static const char* fightResultName(const uint inResult)
+{
+    switch(inResult)
+    {
+        case EventLog::FR_ATTACKER_WON: return "attacker_won";
+        case EventLog::FR_DEFENDER_WON: return "defender_won";
+        case EventLog::FR_BOTH_DIED: return "both_died";
+        default: return "unknown";
+    }
+}
+
+
+static void printRecord(const EventRecord & inRecord)
+{
+    const EventLog::EventTypeEnum type = (EventLog::EventTypeEnum) inRecord.type;
+    printf("round %u %s ", inRecord.round, EventLog::typeName(type));
+    switch(type)
+    {
+        case EventLog::EV_COMMAND_ACCEPTED:
+        case EventLog::EV_COMMAND_REJECTED:
+            if(inRecord.sub == ComputerMove::MT_ISLE_BUILD_SHIPTYPE)
+                printf("move=%s owner=%u isle=%u shiptype=%s\n", moveTypeName(inRecord.sub), inRecord.a, inRecord.b,
+                       qPrintable(Ship::shipTypeName((ShipTypeEnum) inRecord.c)));
+            else if(inRecord.sub == ComputerMove::MT_SHIP_REMOVE_TARGETS or
+                    inRecord.sub == ComputerMove::MT_SHIP_SET_CYCLE_TARGETS)
+                printf("move=%s owner=%u ship=%u index=%d\n", moveTypeName(inRecord.sub), inRecord.a, inRecord.b,
+                       (int) inRecord.c);
+            else
+                printf("move=%s owner=%u source=%u target=%u\n", moveTypeName(inRecord.sub), inRecord.a, inRecord.b,
+                       inRecord.c);
+            break;
+        case EventLog::EV_FIGHT_SHIP:
+            printf("result=%s attacker=%u defender=%u owner=%u force=%g\n", fightResultName(inRecord.sub),
+                   inRecord.a, inRecord.b, inRecord.c, inRecord.value);
+            break;
+        case EventLog::EV_FIGHT_ISLE:
+            printf("result=%s attacker=%u isle=%u owner=%u force=%g\n", fightResultName(inRecord.sub),
+                   inRecord.a, inRecord.b, inRecord.c, inRecord.value);
+            break;
+        case EventLog::EV_SHIP_DELETED:
+            printf("ship=%u owner=%u shiptype=%s damage=%g\n", inRecord.a, inRecord.b,
+                   qPrintable(Ship::shipTypeName((ShipTypeEnum) inRecord.c)), inRecord.value);
+            break;
+        default:
+            printf("sub=%u a=%u b=%u c=%u value=%g\n", inRecord.sub, inRecord.a, inRecord.b, inRecord.c,
+                   inRecord.value);
+    }
+}
+
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Prints a WaterWorld event log as text.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("file", "Event log written by WaterWorld --event-log.");
+    QCommandLineOption categoriesOption("categories", "Comma separated: commands, fights, trash or all.", "list", "all");
+    parser.addOption(categoriesOption);
+    parser.process(app);
+
+    uint categories = EventLog::CAT_NONE;
+    if(parser.positionalArguments().count() != 1 or
+            not EventLog::parseCategories(parser.value(categoriesOption), categories))
+        parser.showHelp(1);
+
+    QVector<EventRecord> records;
+    if(! EventLog::load(parser.positionalArguments().first(), records))
+    {
+        fprintf(stderr, "cannot read %s\n", qPrintable(parser.positionalArguments().first()));
+        return 1;
+    }
+
+    for(const EventRecord & r : records)
+    {
+        if(categories & EventLog::categoryOf((EventLog::EventTypeEnum) r.type))
+            printRecord(r);
+    }
+    return 0;
+}
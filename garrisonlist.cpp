@@ -0,0 +1,57 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+#include <garrisonlist.h>
+#include <ship.h>
+
+
+GarrisonList::GarrisonList()
+    : m_first(0), m_last(0), m_count(0)
+{
+}
+
+
+void GarrisonList::append(Ship *inShip)
+{
+    Q_ASSERT(inShip->m_garrison == 0);
+    inShip->m_garrison = this;
+    inShip->m_garrisonPrev = m_last;
+    inShip->m_garrisonNext = 0;
+    if(m_last)
+        m_last->m_garrisonNext = inShip;
+    else
+        m_first = inShip;
+    m_last = inShip;
+    m_count++;
+}
+
+
+void GarrisonList::remove(Ship *inShip)
+{
+    Q_ASSERT(inShip->m_garrison == this);
+    if(inShip->m_garrisonPrev)
+        inShip->m_garrisonPrev->m_garrisonNext = inShip->m_garrisonNext;
+    else
+        m_first = inShip->m_garrisonNext;
+    if(inShip->m_garrisonNext)
+        inShip->m_garrisonNext->m_garrisonPrev = inShip->m_garrisonPrev;
+    else
+        m_last = inShip->m_garrisonPrev;
+    inShip->m_garrison = 0;
+    inShip->m_garrisonPrev = 0;
+    inShip->m_garrisonNext = 0;
+    m_count--;
+}
+
+
+QVector<Ship*> GarrisonList::ships() const
+{
+    QVector<Ship*> outShips;
+    outShips.reserve(m_count);
+    for(Ship *s = m_first; s; s = s->nextInGarrison())
+        outShips.append(s);
+    return outShips;
+}
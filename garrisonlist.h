@@ -0,0 +1,47 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+#ifndef GARRISONLIST_H
+#define GARRISONLIST_H
+
+
+#include <QVector>
+
+
+class Ship;
+
+
+/**
+ * @brief The GarrisonList class is an intrusive list of ships, which stay at one isle
+ *
+ * The links live inside the ships (see Ship::nextInGarrison()), so joining and
+ * leaving costs O(1) and needs no allocation. A ship is member of at most one list.
+ * Ships add and remove themselves whenever their position type or isle changes.
+ */
+class GarrisonList
+{
+public:
+    GarrisonList();
+
+    void append(Ship *inShip);
+
+    void remove(Ship *inShip);
+
+    Ship* first() const { return m_first; }
+
+    int count() const { return m_count; }
+
+    /* copy of the list in joining order. Use this, if ships may
+     * leave the list while you work on it (fights, position changes) */
+    QVector<Ship*> ships() const;
+
+private:
+    Ship *m_first;
+    Ship *m_last;
+    int m_count;
+};
+
+#endif // GARRISONLIST_H
@@ -0,0 +1,22 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+#ifndef INFOSCREENPAGE_H
+#define INFOSCREENPAGE_H
+
+
+#include <QMetaType>
+
+
+/* Pages of the infoscreen (WaterObjectInfo). Universe needs to know them
+ * in Universe::callInfoScreen(), so this lives outside of the GUI code. */
+enum InfoscreenPageEnum {PAGE_NOTHING = 0, PAGE_WATER = 1, PAGE_ISLE = 2, PAGE_HUMAN_ISLE = 3, PAGE_SHIP = 4, PAGE_HUMAN_SHIP = 5};
+
+// for queued signals between the simulation thread and the GUI
+Q_DECLARE_METATYPE(InfoscreenPageEnum)
+
+
+#endif // INFOSCREENPAGE_H
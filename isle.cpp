@@ -6,37 +6,35 @@
 
 #include <isle.h>
 #include <player.h>
+#include <worldindex.h>
 
 #include <math.h>
-#include <QBrush>
 #include <QDebug>
 
 
-Isle::Isle(const uint inId, const uint inOwner, const QPointF inPos,
-     const QColor inColor)
-    : WaterObject(inId, inOwner, inPos, inColor, 0.0f),
-      m_shipToBuild(ShipTypeEnum::ST_BATTLESHIP)
+Isle::Isle(WorldIndex *inWorldIndex, const uint inId, const uint inOwner, const QPointF inPos)
+    : WaterObject(inId, inOwner, inPos, 0.0f),
+      m_worldIndex(inWorldIndex), m_shipToBuild(ShipTypeEnum::ST_BATTLESHIP),
+      m_statsCounted(false), m_statsOwner(inOwner), m_statsPopulation(0.0f), m_statsTechnology(0.0f)
 {
-    m_shape = new QGraphicsEllipseItem(inPos.x() - 10.0f, inPos.y() - 10.0f, 20.0f, 20.0f);
-    m_shape->setBrush(QBrush(inColor));
-
     m_population  = inOwner > Player::PLAYER_UNSETTLED ? 100.1f : 0.0f;
     m_technology = inOwner > Player::PLAYER_UNSETTLED ? 1.01f : 0.0f;
     m_buildlevel = 0.0f;
     setDefaultTargetNothing();
+    updateStats();
 }
 
 
-void Isle::setOwner(const uint inOwner, const QColor inColor)
+void Isle::setOwner(const uint inOwner)
 {
     m_owner = inOwner;
-    m_color = inColor;
-    m_shape->setBrush(QBrush(inColor));
 
     m_population  = inOwner > Player::PLAYER_UNSETTLED ? 100.1 : 0.0f;
     m_technology = inOwner > Player::PLAYER_UNSETTLED ? 1.01f : 0.0f;
     m_buildlevel = 0.0f;
     setDefaultTargetNothing();
+    markChanged();
+    updateStats();
 }
 
 
@@ -44,6 +42,8 @@ void Isle::setOwner(const uint inOwner, const QColor inColor)
 void Isle::setPopulation(const float inPopulation)
 {
     m_population = inPopulation;
+    markChanged();
+    updateStats();
 }
 
 
@@ -53,12 +53,15 @@ void Isle::setShipToBuild(const ShipTypeEnum inShipToBuild)
         return;
     m_shipToBuild = inShipToBuild;
     m_buildlevel = 0.0f;    // start fresh, sorry user
+    markChanged();
 }
 
 
 void Isle::setMaxTechnology(const float inTechnology)
 {
     m_technology = m_technology < inTechnology ? inTechnology : m_technology;
+    markChanged();
+    updateStats();
 }
 
 
@@ -67,6 +70,7 @@ void Isle::setDefaultTargetIsle(const QPointF inTargetPos, const uint inIsleId)
     m_defaultTargetType = IsleInfo::T_ISLE;
     m_defaultTargetIsle = inIsleId;
     m_defaultTargetPos = inTargetPos;
+    markChanged();
 }
 
 
@@ -75,6 +79,7 @@ void Isle::setDefaultTargetWater(const QPointF inTargetPos)
     m_defaultTargetType = IsleInfo::T_WATER;
     m_defaultTargetIsle = 0;
     m_defaultTargetPos = inTargetPos;
+    markChanged();
 }
 
 
@@ -83,6 +88,25 @@ void Isle::setDefaultTargetNothing()
     m_defaultTargetType = IsleInfo::T_NOTHING;
     m_defaultTargetIsle = 0;
     m_defaultTargetPos = QPointF(0, 0);
+    markChanged();
+}
+
+
+void Isle::markChanged()
+{
+    m_worldIndex->changes.isleChanged(m_id);
+}
+
+
+void Isle::updateStats()
+{
+    if(m_statsCounted)
+        m_worldIndex->stats.removeIsle(m_statsOwner, m_statsPopulation, m_statsTechnology);
+    m_statsCounted = true;
+    m_statsOwner = m_owner;
+    m_statsPopulation = m_population;
+    m_statsTechnology = m_technology;
+    m_worldIndex->stats.addIsle(m_statsOwner, m_statsPopulation, m_statsTechnology);
 }
 
 
@@ -91,7 +115,7 @@ bool Isle::pointInIsle(const QPointF inPos)
     QPointF myPos = pos();
     qreal dx = myPos.x() - inPos.x();
     qreal dy = myPos.y() - inPos.y();
-    return (dx * dx + dy * dy) < 100.0f;
+    return (dx * dx + dy * dy) < RADIUS * RADIUS;
 }
 
 
@@ -99,9 +123,10 @@ bool Isle::nextRound()
 {
     if(m_owner == Player::PLAYER_UNSETTLED)
         return false;
+    markChanged();  // population, technology and buildlevel grow
     if(m_population < 100.0f)
     {   // too few people on isle, they die by loneliness, sad but thats nature...
-        setOwner(Player::PLAYER_UNSETTLED, Player::colorForOwner(Player::PLAYER_UNSETTLED));
+        setOwner(Player::PLAYER_UNSETTLED);
         return false;
     }
     // population formula is based on a logistic function for populations,
@@ -117,6 +142,7 @@ bool Isle::nextRound()
     // grow tech faster.
     // Libre Office (col A is tech, col B is population) =A1 + 0,1 +  0,2 * B1 / 60000
     m_technology = m_technology + 0.01 + 0.1 * m_population / max_population;
+    updateStats();
 
     // Libre Office: = C1 + 0,2 + 0,5 / A1 + 0,5 * B1 / 60000
     m_buildlevel = m_buildlevel + 0.08f + 0.1f * (1.0f / m_technology +  m_population / max_population);
@@ -138,9 +164,11 @@ float Isle::force() const
 void Isle::takeDamage(const float inOpponentForce)
 {
     m_population = m_population - inOpponentForce * 1000 / m_technology;
+    markChanged();
+    updateStats();
     if(m_population < 100.0f)
     {
         // die on too much damage
-        setOwner(Player::PLAYER_UNSETTLED, Player::colorForOwner(Player::PLAYER_UNSETTLED));
+        setOwner(Player::PLAYER_UNSETTLED);
     }
 }
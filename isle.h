@@ -10,9 +10,12 @@
 
 #include <waterobject.h>
 #include <ship.h>
-#include <QGraphicsEllipseItem>
+#include <garrisonlist.h>
 #include <QPointF>
-#include <QColor>
+#include <QMetaType>
+
+
+class WorldIndex;
 
 
 
@@ -22,7 +25,6 @@ struct IsleInfo
     enum TargetEnum {T_NOTHING, T_WATER, T_ISLE};
     uint id;
     uint owner;
-    QColor color;
     QPointF pos;
     float population;
     float technology;
@@ -37,16 +39,16 @@ struct IsleInfo
 class Isle : public WaterObject
 {
 public:
-    Isle(const uint inId, const uint inOwner, const QPointF inPos,
-         const QColor inColor);
+    // isles are circles
+    static constexpr float RADIUS = 10.0f;
 
-    QGraphicsEllipseItem* shape() const { return m_shape; }
+    // isles report their changes to inWorldIndex->changes
+    Isle(WorldIndex *inWorldIndex, const uint inId, const uint inOwner, const QPointF inPos);
 
     IsleInfo info() const {
         IsleInfo outInfo;
         outInfo.id = m_id;
         outInfo.owner = m_owner;
-        outInfo.color = m_color;
         outInfo.pos = m_pos;
         outInfo.population = m_population;
         outInfo.technology = m_technology;
@@ -59,7 +61,7 @@ public:
     }
 
     // setter
-    void setOwner(const uint inOwner, const QColor inColor);
+    void setOwner(const uint inOwner);
 
     void setPopulation(const float inPopulation);
 
@@ -83,8 +85,19 @@ public:
     float force() const;
     void takeDamage(const float inOpponentForce);
 
+    // ships with SP_ONISLE and SP_PATROL at this isle, of any owner
+    GarrisonList & shipsOnIsle() { return m_shipsOnIsle; }
+    GarrisonList & patrolShips() { return m_patrolShips; }
+
 private:
-    QGraphicsEllipseItem *m_shape;      // display of the isle
+    WorldIndex *m_worldIndex;
+
+    // tell the change feed about us
+    void markChanged();
+
+    // move our isle count, population and technology in m_worldIndex->stats to the current values
+    void updateStats();
+
     float m_population;                 // number of people on island
     float m_buildlevel;     // percentage of building a new ship. 1 means, release a new ship during nextRound()
     ShipTypeEnum m_shipToBuild; // we build this type of ship (user selects)
@@ -93,6 +106,19 @@ private:
     IsleInfo::TargetEnum m_defaultTargetType;
     uint m_defaultTargetIsle;   //
     QPointF m_defaultTargetPos;
+
+    // maintained by the ships, see Ship::updateGarrison()
+    GarrisonList m_shipsOnIsle;
+    GarrisonList m_patrolShips;
+
+    // what we have added to m_worldIndex->stats, see updateStats()
+    bool m_statsCounted;
+    uint m_statsOwner;
+    float m_statsPopulation;
+    float m_statsTechnology;
 };
 
+
+Q_DECLARE_METATYPE(IsleInfo)
+
 #endif // ISLE_H
@@ -5,14 +5,72 @@
 
 
 #include "mainwindow.h"
+#include <random.h>
+#include <universe.h>
+#include <tracerecorder.h>
 #include <QApplication>
+#include <QCommandLineParser>
+#include <QDebug>
 
 
 int main(int argc, char *argv[])
 {
     QApplication a(argc, argv);
-    MainWindow w;
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("WaterWorld");
+    parser.addHelpOption();
+    QCommandLineOption seedOption("seed", "Create the universe from seed <n>, same seed gives the same game.", "n");
+    QCommandLineOption eventLogOption("event-log", "Record events and write them to <file> on exit, "
+                                      "see waterworld_eventlog.", "file");
+    QCommandLineOption eventCategoriesOption("event-categories", "Events to record: commands, fights, trash or all.",
+                                             "list", "all");
+    QCommandLineOption statsOption("stats", "Record isles, population, technology, ships and fights of every "
+                                   "player after each round and write them to <file> on exit, see waterworld_stats.",
+                                   "file");
+    QCommandLineOption profileOption("profile", "Print the time of each phase and the counters after every round.");
+    QCommandLineOption traceOption("trace", "Write a Chrome trace-event JSON file of the session to <file>, "
+                                   "for chrome://tracing or ui.perfetto.dev.", "file");
+    parser.addOption(seedOption);
+    parser.addOption(eventLogOption);
+    parser.addOption(traceOption);
+    parser.addOption(eventCategoriesOption);
+    parser.addOption(statsOption);
+    parser.addOption(profileOption);
+    parser.process(a);
+
+    quint64 seed = Random::seedFromClock();
+    if(parser.isSet(seedOption))
+    {
+        bool ok = false;
+        seed = parser.value(seedOption).toULongLong(&ok);
+        if(! ok)
+            parser.showHelp(1);
+    }
+
+    uint eventCategories = EventLog::CAT_NONE;
+    if(parser.isSet(eventLogOption) and
+            not EventLog::parseCategories(parser.value(eventCategoriesOption), eventCategories))
+        parser.showHelp(1);
+
+    if(parser.isSet(traceOption) and not TraceRecorder::instance().start(parser.value(traceOption)))
+        qWarning() << "cannot write trace" << parser.value(traceOption);
+
+    MainWindow w(seed);
+    // no round has run yet, so this is safe although the universe has its own thread
+    w.universe()->eventLog().setCategories(eventCategories);
+    w.universe()->setPrintProfile(parser.isSet(profileOption));
+    if(parser.isSet(statsOption))
+        w.universe()->statsRecorder().start(w.universe()->numberOfEnemies() + 1);
     w.show();
     //a.aboutQt();
-    return a.exec();
+    int result = a.exec();
+    w.stopSimulation();
+    TraceRecorder::instance().stop();
+
+    if(parser.isSet(eventLogOption) and not w.universe()->eventLog().save(parser.value(eventLogOption)))
+        qWarning() << "cannot write event log" << parser.value(eventLogOption);
+    if(parser.isSet(statsOption) and not w.universe()->statsRecorder().save(parser.value(statsOption)))
+        qWarning() << "cannot write statistics" << parser.value(statsOption);
+    return result;
 }
@@ -8,15 +8,18 @@
 #include "ui_mainwindow.h"
 #include "shiplistitem.h"
 #include "pathlistitem.h"
+#include <tracerecorder.h>
 
+#include <QApplication>
+#include <QInputDialog>
 #include <QPaintEvent>
 #include <QTableWidget>
 #include <QTableWidgetItem>
 #include <QDebug>
 
 
-MainWindow::MainWindow(QWidget *inParent) :
-    QMainWindow(inParent), m_ui(new Ui::MainWindow)
+MainWindow::MainWindow(const quint64 inSeed, QWidget *inParent) :
+    QMainWindow(inParent), m_ui(new Ui::MainWindow), m_fastForwardRounds(10)
 {
     m_ui->setupUi(this);
 
@@ -50,8 +53,14 @@ MainWindow::MainWindow(QWidget *inParent) :
     m_waterObjectInfo = new WaterObjectInfo;
     infoLayout->addWidget(m_waterObjectInfo);
 
-    // universe show isles
-    m_universe = new Universe(this, m_universeScene, m_universeScene->width(), m_universeScene->height(), 20, 3);
+    // universe show isles. It plays the rounds on a thread of its own, so the window
+    // stays responsive. We talk to it by queued calls and read its snapshots
+    Universe::registerMetaTypes();
+    m_universe = new Universe(0, m_universeScene->width(), m_universeScene->height(), 20, 3, inSeed);
+    m_simulationThread = new QThread(this);
+    m_simulationThread->setObjectName("simulation");
+    m_universe->moveToThread(m_simulationThread);
+    m_universeRenderer = new UniverseRenderer(m_universeScene, m_minimapView, m_universe, this);
 
     // overview dialog
     m_overviewDialog = new OverviewDialog(m_universe->numberOfEnemies() + 1, this);
@@ -62,13 +71,15 @@ MainWindow::MainWindow(QWidget *inParent) :
     connect(m_ui->actionZoomOut, SIGNAL(triggered(bool)), m_universeView, SLOT(slotZoomOut()));
     connect(m_ui->actionZoomNorm, SIGNAL(triggered(bool)), m_universeView, SLOT(slotZoomNorm()));
     connect(m_ui->actionNextRound, SIGNAL(triggered(bool)), this, SLOT(slotNextRound()));
+    connect(m_ui->actionFastForward, SIGNAL(triggered(bool)), this, SLOT(slotFastForward()));
     connect(m_ui->actionOverview, SIGNAL(triggered()), this, SLOT(slotToggleOverviewDialog()));
+    connect(m_universe, SIGNAL(sigUniverseChanged()), this, SLOT(slotUpdateOverviewDialog()));
 
     connect(m_universeView, SIGNAL(sigUniverseViewClicked(QPointF)), m_universe, SLOT(slotUniverseViewClicked(QPointF)));
     connect(m_universeView, SIGNAL(sigUniverseViewClickedFinishShipTarget(QPointF,uint)),
-            m_universe, SLOT(slotUniverseViewClickedFinishShipTarget(QPointF,uint)));
+            this, SLOT(slotShipTargetPicked(QPointF,uint)));
     connect(m_universeView, SIGNAL(sigUniverseViewClickedFinishIsleTarget(QPointF,uint)),
-            m_universe, SLOT(slotUniverseViewClickedFinishIsleTarget(QPointF,uint)));
+            this, SLOT(slotIsleTargetPicked(QPointF,uint)));
 
     connect(m_universe, SIGNAL(sigShowInfoWater()), this, SLOT(slotShowUniverseInfoWater()));
     connect(m_universe, SIGNAL(sigShowInfoIsle(IsleInfo)), this, SLOT(slotShowUniverseInfoIsle(IsleInfo)));
@@ -77,7 +88,7 @@ MainWindow::MainWindow(QWidget *inParent) :
     connect(m_universe, SIGNAL(sigShowInfoShip(ShipInfo)), this, SLOT(slotShowUniverseInfoShip(ShipInfo)));
     connect(m_universe, SIGNAL(sigShowInfoHumanShip(ShipInfo, QVector<Target>)),
             this, SLOT(slotShowUniverseInfoHumanShip(ShipInfo, QVector<Target>)));
-    connect(m_universe, SIGNAL(sigRecallInfoscreen()), this, SLOT(slotRecallInfoscreen()));
+    connect(m_universe, SIGNAL(sigRoundFinished()), this, SLOT(slotRoundFinished()));
 
     // Infoscreen (WaterObjectInfo) -> human isle
     connect(m_waterObjectInfo, SIGNAL(signalDeleteShipById(uint)), this, SLOT(slotDeleteShip(uint)));
@@ -94,18 +105,32 @@ MainWindow::MainWindow(QWidget *inParent) :
     connect(m_waterObjectInfo, SIGNAL(signalSetRepeatTargetsById(uint,bool)),
             this, SLOT(slotRepeatShipTargets(uint,bool)));
     connect(m_waterObjectInfo, SIGNAL(signalDeleteTargetByIndex(uint,int)), this, SLOT(slotDeleteTarget(uint,int)));
+
+    m_simulationThread->start();
 }
 
 
 MainWindow::~MainWindow()
 {
+    stopSimulation();
+    delete m_universe;
     delete m_overviewDialog;
     delete m_ui;
 }
 
 
+void MainWindow::stopSimulation()
+{
+    if(! m_simulationThread->isRunning())
+        return;
+    m_simulationThread->quit();
+    m_simulationThread->wait();
+}
+
+
 void MainWindow::slotRecallInfoscreen()
 {
+    WW_TRACE_SPAN("MainWindow::slotRecallInfoscreen");
     uint id = 0;
 
     switch(m_waterObjectInfo->lastCalledPage())
@@ -127,7 +152,9 @@ void MainWindow::slotRecallInfoscreen()
 
 void MainWindow::slotRecallInfoscreenById(uint objectId)
 {
-    m_universe->callInfoScreen(m_waterObjectInfo->lastCalledPage(), objectId);
+    QMetaObject::invokeMethod(m_universe, "callInfoScreen", Qt::QueuedConnection,
+                              Q_ARG(InfoscreenPageEnum, m_waterObjectInfo->lastCalledPage()),
+                              Q_ARG(uint, objectId));
 }
 
 
@@ -164,6 +191,7 @@ void MainWindow::slotShowUniverseInfoShip(ShipInfo shipInfo)
 void MainWindow::slotShowUniverseInfoHumanShip(ShipInfo shipInfo, QVector<Target> shipTargets)
 {
     m_universeView->hidePathItem();
+    QSharedPointer<const UniverseSnapshot> snapshot = m_universe->snapshot();
     QVector<ExtendedTarget> extTargetList;
     for(Target t : shipTargets)
     {
@@ -173,16 +201,14 @@ void MainWindow::slotShowUniverseInfoHumanShip(ShipInfo shipInfo, QVector<Target
         {
             case Target::T_SHIP:
             {
-                ShipInfo tShipInfo;
-                m_universe->shipForId(t.id, tShipInfo);
-                ext.target_owner = tShipInfo.owner;
+                const ShipInfo *tShipInfo = snapshot->ship(t.id);
+                ext.target_owner = tShipInfo ? tShipInfo->owner : 0;
             }
                 break;
             case Target::T_ISLE:
             {
-                IsleInfo tIsleInfo;
-                m_universe->isleForId(t.id, tIsleInfo);
-                ext.target_owner = tIsleInfo.owner;
+                const IsleInfo *tIsleInfo = snapshot->isle(t.id);
+                ext.target_owner = tIsleInfo ? tIsleInfo->owner : 0;
             }
                 break;
             case Target::T_WATER:
@@ -202,20 +228,33 @@ void MainWindow::slotShowUniverseInfoHumanShip(ShipInfo shipInfo, QVector<Target
 
 void MainWindow::slotDeleteShip(uint shipId)
 {
-    // this here instantly deletes a ship, because user wants this
-    m_universe->deleteShipOnIsle(shipId);
+    ComputerMove move;
+    move.moveType = ComputerMove::MT_SHIP_DELETE;
+    move.sourceId = shipId;
+    postHumanMove(move);
+    slotRecallInfoscreen();
 }
 
 
 void MainWindow::slotSetShipPartrol(uint shipId)
 {
-    m_universe->setShipPatrolsIsle(shipId);
+    ComputerMove move;
+    move.moveType = ComputerMove::MT_SHIP_TOGGLE_PATROL;
+    move.sourceId = shipId;
+    postHumanMove(move);
+    slotRecallInfoscreen();
 }
 
 
-void MainWindow::slotAddShipToFleet(uint isleId, uint fleetId, uint shipId)
+void MainWindow::slotAddShipToFleet(uint /*isleId*/, uint fleetId, uint shipId)
 {
-    m_universe->shipAddToFleet(m_universeScene, isleId, fleetId, shipId);
+    // the universe knows the isle of the ship
+    ComputerMove move;
+    move.moveType = ComputerMove::MT_SHIP_ADD_TO_FLEET;
+    move.sourceId = shipId;
+    move.targetId = fleetId;
+    postHumanMove(move);
+    slotRecallInfoscreen();
 }
 
 
@@ -224,12 +263,14 @@ void MainWindow::slotSetNewTargetForShip(uint shipId)
     InfoscreenPageEnum page = m_waterObjectInfo->lastCalledPage();
     if(page == PAGE_HUMAN_ISLE)
     {
-        ShipInfo shipInfo;
-        QVector<Target> shipTargets;
-        m_universe->shipForId(shipId, shipInfo, shipTargets);
+        QSharedPointer<const UniverseSnapshot> snapshot = m_universe->snapshot();
+        const ShipInfo *shipInfo = snapshot->ship(shipId);
+        if(! shipInfo)
+            return;
+        QVector<Target> shipTargets = snapshot->humanShipTargets.value(shipId);
         if(shipTargets.count() > 0)
-            m_universeView->showShipPath(shipInfo.pos, shipTargets, shipInfo.cycleTargetList);
-        m_universeView->toggleShipWantsTarget(shipInfo.attachPos, shipId, shipInfo.technology);
+            m_universeView->showShipPath(shipInfo->pos, shipTargets, shipInfo->cycleTargetList);
+        m_universeView->toggleShipWantsTarget(shipInfo->attachPos, shipId, shipInfo->technology);
     }
     else if(page == PAGE_HUMAN_SHIP)
     {
@@ -237,56 +278,134 @@ void MainWindow::slotSetNewTargetForShip(uint shipId)
         m_universeView->toggleShipWantsTarget(shipInfo.attachPos, shipInfo.id, shipInfo.technology);
     }
     // now, its up to m_universeView to show visible feedback until target gets clicked.
-    // -> then, m_universe sets up the target
-    // -> then, m_universe shows up this isle again (if it was triggered by isle buttons)
+    // -> then, slotShipTargetPicked() sends the target to m_universe
+    // -> and shows up this isle again (if it was triggered by isle buttons)
 }
 
 
 void MainWindow::slotSetNewTargetForIsle(uint isleId)
 {
-    IsleInfo isleInfo;
-    m_universe->isleForId(isleId, isleInfo);
-    m_universeView->toggleIsleWantsTarget(isleInfo.pos, isleInfo.id);
+    QSharedPointer<const UniverseSnapshot> snapshot = m_universe->snapshot();
+    const IsleInfo *isleInfo = snapshot->isle(isleId);
+    if(isleInfo)
+        m_universeView->toggleIsleWantsTarget(isleInfo->pos, isleInfo->id);
+}
+
+
+void MainWindow::slotShipTargetPicked(QPointF scenePos, uint shipId)
+{
+    ComputerMove move;
+    move.moveType = ComputerMove::MT_SHIP_PICK_TARGET;
+    move.sourceId = shipId;
+    move.pos = scenePos;
+    postHumanMove(move);
+    // call the infoscreen again, as the reason for a new target is one of 2 infoscreen-buttons
+    slotRecallInfoscreen();
+}
+
+
+void MainWindow::slotIsleTargetPicked(QPointF scenePos, uint isleId)
+{
+    ComputerMove move;
+    move.moveType = ComputerMove::MT_ISLE_PICK_DEFAULT_TARGET;
+    move.sourceId = isleId;
+    move.pos = scenePos;
+    postHumanMove(move);
+    slotRecallInfoscreen();
 }
 
 
 void MainWindow::slotRemoveIsleTarget(uint isleId)
 {
-    m_universe->removeDefaultIsleTarget(isleId);
+    ComputerMove move;
+    move.moveType = ComputerMove::MT_ISLE_REMOVE_DEFAULT_TARGET;
+    move.sourceId = isleId;
+    postHumanMove(move);
     slotRecallInfoscreen();
 }
 
 
 void MainWindow::slotBuildNewShipType(uint isleId, ShipTypeEnum newType)
 {
-    m_universe->isleSetShipToBuild(isleId, newType);
+    ComputerMove move;
+    move.moveType = ComputerMove::MT_ISLE_BUILD_SHIPTYPE;
+    move.sourceId = isleId;
+    move.shipTypeToBuild = newType;
+    postHumanMove(move);
 }
 
 
 void MainWindow::slotRepeatShipTargets(uint shipId, bool repeat)
 {
-    m_universe->shipSetCycleTargets(shipId, repeat);
+    ComputerMove move;
+    move.moveType = ComputerMove::MT_SHIP_SET_CYCLE_TARGETS;
+    move.sourceId = shipId;
+    move.index = repeat ? 1 : 0;
+    postHumanMove(move);
 }
 
 
 void MainWindow::slotDeleteTarget(uint shipId, int index)
 {
-    if(index < 0)
-        m_universe->removeAllShipTargets(shipId);
-    else
-        m_universe->removeShipTargetByIndex(shipId, index);
+    // index < 0 removes all targets
+    ComputerMove move;
+    move.moveType = ComputerMove::MT_SHIP_REMOVE_TARGETS;
+    move.sourceId = shipId;
+    move.index = index;
+    postHumanMove(move);
     slotRecallInfoscreen();
 }
 
 
+void MainWindow::postHumanMove(const ComputerMove & inMove)
+{
+    // moves and the infoscreen calls after them arrive in order, so the
+    // infoscreen already shows the result
+    if(! m_universe->postHumanMove(inMove))
+        qWarning() << "MainWindow::postHumanMove() -> too many moves waiting, move dropped";
+}
+
+
 void MainWindow::slotNextRound()
 {
-    m_universe->nextRound(m_universeScene);
+    WW_TRACE_SPAN("MainWindow::slotNextRound");
+    // one round at a time, slotRoundFinished() enables the actions again
+    m_ui->actionNextRound->setEnabled(false);
+    m_ui->actionFastForward->setEnabled(false);
+    QMetaObject::invokeMethod(m_universe, "nextRound", Qt::QueuedConnection);
+}
+
+
+void MainWindow::slotFastForward()
+{
+    bool ok = false;
+    int rounds = QInputDialog::getInt(this, "Fast forward", "Rounds to play:", m_fastForwardRounds,
+                                      1, 100000, 1, &ok);
+    if(! ok)
+        return;
+    m_fastForwardRounds = rounds;
+
+    WW_TRACE_SPAN_ARG("MainWindow::slotFastForward", "rounds", rounds);
+    m_ui->actionNextRound->setEnabled(false);
+    m_ui->actionFastForward->setEnabled(false);
+    QApplication::setOverrideCursor(Qt::BusyCursor);
+    // the scene gets synced once at the end, see Universe::nextRounds()
+    QMetaObject::invokeMethod(m_universe, "nextRounds", Qt::QueuedConnection, Q_ARG(uint, rounds));
+}
+
+
+void MainWindow::slotRoundFinished()
+{
+    WW_TRACE_SPAN("MainWindow::slotRoundFinished");
+    m_ui->actionNextRound->setEnabled(true);
+    m_ui->actionFastForward->setEnabled(true);
+    if(QApplication::overrideCursor())
+        QApplication::restoreOverrideCursor();
+
     // call the infoscreen again. so there is a live update of ships and isles
-    // during nextRound()
+    // during nextRound(). The scene is up to date already, the renderer repaints
+    // only what changed, see ShipBatchItem::endUpdate() and UniverseScene::setIsle()
     slotRecallInfoscreen();
-    // remove artefacts of moving ships
-    m_universeScene->update(m_universeScene->sceneRect());
 }
 
 
@@ -294,15 +413,17 @@ void MainWindow::slotToggleOverviewDialog()
 {
     if(m_overviewDialog->isHidden())
     {
-        QList<IsleInfo> isleInfoList;
-        m_universe->getAllIsleInfos(isleInfoList);
-        m_overviewDialog->updateIsleInfos(isleInfoList);
-
-        QList<ShipInfo> shipInfoList;
-        m_universe->getAllShipInfos(shipInfoList);
-        m_overviewDialog->updateShipInfos(shipInfoList);
+        m_overviewDialog->updateStats(m_universe->snapshot()->playerStats);
         m_overviewDialog->show();
     }
     else
         m_overviewDialog->hide();
 }
+
+
+void MainWindow::slotUpdateOverviewDialog()
+{
+    // the stats are kept up to date by the universe, showing them costs O(players)
+    if(m_overviewDialog->isVisible())
+        m_overviewDialog->updateStats(m_universe->snapshot()->playerStats);
+}
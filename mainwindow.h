@@ -12,10 +12,12 @@
 #include <universeview.h>
 #include <minimapview.h>
 #include <universe.h>
+#include <universerenderer.h>
 #include <overviewdialog.h>
 #include <waterobjectinfo.h>
 
 #include <QMainWindow>
+#include <QThread>
 
 namespace Ui {
 class MainWindow;
@@ -27,9 +29,17 @@ class MainWindow : public QMainWindow
     Q_OBJECT
 
 public:
-    explicit MainWindow(QWidget *inParent = 0);
+    // inSeed is handed over to the universe, see Universe::Universe()
+    explicit MainWindow(const quint64 inSeed, QWidget *inParent = 0);
     ~MainWindow();
 
+    // the universe lives on its own thread, see Universe for what may be called directly
+    Universe * universe() const { return m_universe; }
+
+    // finish the current round and stop the simulation thread. Afterwards, the
+    // universe may be used directly from this thread
+    void stopSimulation();
+
 private:
     // common ui parts of main window
     Ui::MainWindow *m_ui;
@@ -44,8 +54,18 @@ private:
     // Info about water objects, the infoscreen
     WaterObjectInfo *m_waterObjectInfo;
 
-    // Universe where ships and isles live
+    // Universe where ships and isles live, on m_simulationThread
     Universe *m_universe;
+    QThread *m_simulationThread;
+
+    // displays the universe within m_universeScene
+    UniverseRenderer *m_universeRenderer;
+
+    // rounds of the last fast forward, offered again next time
+    int m_fastForwardRounds;
+
+    // hand an order of the user over to the universe
+    void postHumanMove(const ComputerMove & inMove);
 
 private slots:
     // unverse or infoscreen wants us call infoscreen again
@@ -68,6 +88,10 @@ private slots:
     void slotRemoveIsleTarget(uint isleId);
     void slotBuildNewShipType(uint isleId, ShipTypeEnum newType);
 
+    // user clicked the target, after one of the above
+    void slotShipTargetPicked(QPointF scenePos, uint shipId);
+    void slotIsleTargetPicked(QPointF scenePos, uint isleId);
+
     // user clicked a button on info view -> human ship
     void slotRepeatShipTargets(uint shipId, bool repeat);
     void slotDeleteTarget(uint shipId, int index);
@@ -75,8 +99,16 @@ private slots:
     // nextround
     void slotNextRound();
 
+    // asks for a number of rounds and plays them without drawing in between
+    void slotFastForward();
+
+    // the simulation thread is done with nextRound() or nextRounds()
+    void slotRoundFinished();
+
     // overview dialog
     void slotToggleOverviewDialog();
+    // refresh an open overview dialog after the universe changed
+    void slotUpdateOverviewDialog();
 };
 
 #endif // MAINWINDOW_H
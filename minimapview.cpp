@@ -5,13 +5,89 @@
 
 
 #include "minimapview.h"
+#include <playercolor.h>
+#include <tracerecorder.h>
 #include <QMouseEvent>
+#include <QPainter>
 #include <QDebug>
 
 
 MinimapView::MinimapView(QWidget *inParent) :
-    QGraphicsView(inParent)
+    QGraphicsView(inParent),
+    m_shipCount(RASTER_SIZE * RASTER_SIZE, 0), m_shipOwner(RASTER_SIZE * RASTER_SIZE, 0)
 {
+    // scene changes are none of our business, updateRaster() repaints
+    setViewportUpdateMode(QGraphicsView::NoViewportUpdate);
+}
+
+
+void MinimapView::updateRaster(const UniverseSnapshot & inSnapshot)
+{
+    WW_TRACE_SPAN("MinimapView::updateRaster");
+    const QRectF area = sceneRect();
+    if(area.isEmpty())
+        return;
+
+    bool islesChanged = m_isleLayer.isNull() or m_isleOwners.count() != inSnapshot.isles.count();
+    for(int i = 0; i < inSnapshot.isles.count() and not islesChanged; i++)
+        islesChanged = m_isleOwners.at(i) != inSnapshot.isles.at(i).owner;
+    if(islesChanged)
+    {
+        m_isleLayer = QImage(RASTER_SIZE, RASTER_SIZE, QImage::Format_RGB32);
+        m_isleLayer.fill(Qt::white);
+        QPainter painter(&m_isleLayer);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setPen(Qt::NoPen);
+        const qreal radius = qMax(1.0, Isle::RADIUS * RASTER_SIZE / area.width());
+        m_isleOwners.resize(inSnapshot.isles.count());
+        for(int i = 0; i < inSnapshot.isles.count(); i++)
+        {
+            const IsleInfo & isle = inSnapshot.isles.at(i);
+            m_isleOwners[i] = isle.owner;
+            painter.setBrush(PlayerColor::colorForOwner(isle.owner));
+            painter.drawEllipse(QPointF((isle.pos.x() - area.left()) * RASTER_SIZE / area.width(),
+                                        (isle.pos.y() - area.top()) * RASTER_SIZE / area.height()),
+                                radius, radius);
+        }
+    }
+
+    // one copy of the isle layer, then only pixels with ships get touched
+    m_raster = m_isleLayer.copy();
+    int x, y;
+    for(const ShipInfo & ship : inSnapshot.ships)
+    {
+        if(ship.posType != ShipPositionEnum::SP_OCEAN or not rasterPixel(ship.pos, x, y))
+            continue;
+        const int index = y * RASTER_SIZE + x;
+        m_shipCount[index]++;
+        m_shipOwner[index] = ship.owner;
+    }
+    // the more ships, the darker. Resets the counts for the next call
+    for(const ShipInfo & ship : inSnapshot.ships)
+    {
+        if(ship.posType != ShipPositionEnum::SP_OCEAN or not rasterPixel(ship.pos, x, y))
+            continue;
+        const int index = y * RASTER_SIZE + x;
+        if(m_shipCount.at(index) == 0)
+            continue;   // done already
+        const QRgb rgb = PlayerColor::colorForOwner(m_shipOwner.at(index))
+                .darker(100 + 20 * qMin(m_shipCount.at(index), (quint16) 8)).rgb();
+        m_shipCount[index] = 0;
+        // a ship is wider than one pixel
+        for(int dy = 0; dy < 2 and y + dy < RASTER_SIZE; dy++)
+            for(int dx = 0; dx < 2 and x + dx < RASTER_SIZE; dx++)
+                m_raster.setPixel(x + dx, y + dy, rgb);
+    }
+    viewport()->update();
+}
+
+
+bool MinimapView::rasterPixel(const QPointF inScenePos, int & outX, int & outY) const
+{
+    const QRectF area = sceneRect();
+    outX = (int) ((inScenePos.x() - area.left()) * RASTER_SIZE / area.width());
+    outY = (int) ((inScenePos.y() - area.top()) * RASTER_SIZE / area.height());
+    return outX >= 0 and outX < RASTER_SIZE and outY >= 0 and outY < RASTER_SIZE;
 }
 
 
@@ -20,3 +96,16 @@ void MinimapView::mousePressEvent(QMouseEvent *inMouseEvent)
     //qDebug()  << "Minimap sends Click: " << mapToScene( inMouseEvent->pos() );
     emit sigMinimapClicked( mapToScene(inMouseEvent->pos()) );
 }
+
+
+void MinimapView::paintEvent(QPaintEvent *inPaintEvent)
+{
+    WW_TRACE_SPAN("MinimapView::paintEvent");
+    Q_UNUSED(inPaintEvent);
+    QPainter painter(viewport());
+    painter.fillRect(viewport()->rect(), palette().base());
+    if(m_raster.isNull())
+        return;
+    // where the scene would be, so clicks still match
+    painter.drawImage(mapFromScene(sceneRect()).boundingRect(), m_raster);
+}
@@ -7,9 +7,20 @@
 #define MINIMAPVIEW_H
 
 
+#include <universesnapshot.h>
 #include <QGraphicsView>
+#include <QImage>
+#include <QVector>
 
 
+/**
+ * @brief The MinimapView class shows the whole universe as a small raster
+ *
+ * The view keeps the scene only to map clicks into scene coordinates, it never renders
+ * the scene items. UniverseRenderer hands every new snapshot to updateRaster(), which
+ * draws isle owners and ship density into an image of RASTER_SIZE pixels. So the cost
+ * of the minimap does not grow with the number of items in the scene.
+ */
 class MinimapView : public QGraphicsView
 {
     Q_OBJECT
@@ -17,6 +28,9 @@ class MinimapView : public QGraphicsView
 public:
     explicit MinimapView(QWidget *inParent = 0);
 
+    // draw inSnapshot into the raster and show it
+    void updateRaster(const UniverseSnapshot & inSnapshot);
+
 protected:
     /**
      * @brief MinimapView::mousePressEvent - react on mouse press events inside of minimap
@@ -26,6 +40,26 @@ protected:
      */
     void mousePressEvent(QMouseEvent *inMouseEvent);
 
+    // draws the raster where the view would show the scene
+    void paintEvent(QPaintEvent *inPaintEvent);
+
+private:
+    static const int RASTER_SIZE = 200;
+
+    // pixel of the raster, false if inScenePos is outside
+    bool rasterPixel(const QPointF inScenePos, int & outX, int & outY) const;
+
+    // isles change owner rarely, they are drawn only then
+    QImage m_isleLayer;
+    QVector<uint> m_isleOwners;
+
+    // m_isleLayer plus ships
+    QImage m_raster;
+
+    // ships per pixel and owner of the last one, 0 between updateRaster() calls
+    QVector<quint16> m_shipCount;
+    QVector<uint> m_shipOwner;
+
 signals:
     // send Click event over to someone else (universe might be interested, because of repositioning)
     void sigMinimapClicked(QPointF screenPos);
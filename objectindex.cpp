@@ -0,0 +1,49 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+#include <objectindex.h>
+
+
+ObjectIndex::ObjectIndex()
+{
+}
+
+
+void ObjectIndex::insert(const uint inId, const int inSlot)
+{
+    int oldSize = m_slots.count();
+    if(inId >= (uint) oldSize)
+    {
+        // ids are mostly increasing, so grow in bigger steps
+        int newSize = oldSize * 2 > (int) inId ? oldSize * 2 : inId + 1;
+        m_slots.resize(newSize);
+        for(int i = oldSize; i < newSize; i++)
+            m_slots[i] = -1;
+    }
+    m_slots[inId] = inSlot;
+}
+
+
+void ObjectIndex::setSlot(const uint inId, const int inSlot)
+{
+    Q_ASSERT(slot(inId) >= 0);
+    m_slots[inId] = inSlot;
+}
+
+
+void ObjectIndex::remove(const uint inId)
+{
+    if(slot(inId) < 0)
+        return;
+    m_slots[inId] = -1;
+}
+
+
+void ObjectIndex::clear()
+{
+    m_slots.clear();
+}
+
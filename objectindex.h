@@ -0,0 +1,49 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+#ifndef OBJECTINDEX_H
+#define OBJECTINDEX_H
+
+
+#include <QVector>
+
+
+/**
+ * @brief The ObjectIndex class maps ids of water objects to their slot (index) in a container
+ *
+ * Universe keeps its isles and ships in containers and needs to find them by id all the time.
+ * This is a dense table indexed by id, so a lookup is one array access and does not
+ * depend on the order in which ids get inserted.
+ */
+class ObjectIndex
+{
+public:
+    ObjectIndex();
+
+    // id is now stored at inSlot
+    void insert(const uint inId, const int inSlot);
+
+    // object was moved within its container
+    void setSlot(const uint inId, const int inSlot);
+
+    // id is gone, slot() returns -1 from now on
+    void remove(const uint inId);
+
+    void clear();
+
+    // returns the slot of inId or -1, if there is no such object
+    int slot(const uint inId) const
+    {
+        if(inId >= (uint) m_slots.count())
+            return -1;
+        return m_slots.at(inId);
+    }
+
+private:
+    QVector<int> m_slots;   // index is the id, -1: no object with this id
+};
+
+#endif // OBJECTINDEX_H
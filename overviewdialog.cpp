@@ -7,9 +7,9 @@
 #include "overviewdialog.h"
 #include "ui_overviewdialog.h"
 #include <player.h>
+#include <playercolor.h>
 
 #include <QStringList>
-#include <QVector>
 #include <QDebug>
 #include <QTableWidgetItem>
 #include <QPixmap>
@@ -23,7 +23,7 @@ OverviewDialog::OverviewDialog(const uint inNumPlayer, QWidget *inParent) :
 
     // Player + "ALL" + "0" (No Player)
     m_ui->tableWidget->setRowCount(m_numPlayer + 2);
-    m_ui->tableWidget->setColumnCount(3);
+    m_ui->tableWidget->setColumnCount(4);
 
     // Vertical Table Header
     QStringList vertLabels;
@@ -34,7 +34,7 @@ OverviewDialog::OverviewDialog(const uint inNumPlayer, QWidget *inParent) :
 
     // Horizontal Table Header
     QStringList horzLabels;
-    horzLabels << "Isle" << "Population" << "Ships";
+    horzLabels << "Isle" << "Population" << "Ships" << "Force";
     m_ui->tableWidget->setHorizontalHeaderLabels(horzLabels);
 
     // set table widget items for all columns
@@ -48,7 +48,7 @@ OverviewDialog::OverviewDialog(const uint inNumPlayer, QWidget *inParent) :
         {
             // icon in the color of player
             QPixmap p(20, 20);
-            p.fill(Player::colorForOwner(i));
+            p.fill(PlayerColor::colorForOwner(i));
             m_ui->tableWidget->verticalHeaderItem(i)->setIcon(p);
         }
         m_ui->tableWidget->setItem(i, TC_ISLES, it_0);
@@ -62,6 +62,11 @@ OverviewDialog::OverviewDialog(const uint inNumPlayer, QWidget *inParent) :
         QTableWidgetItem *it_2 = new QTableWidgetItem;
         it_2->setTextAlignment(Qt::AlignHCenter);
         m_ui->tableWidget->setItem(i, TC_SHIPS, it_2);
+
+        // column force
+        QTableWidgetItem *it_3 = new QTableWidgetItem;
+        it_3->setTextAlignment(Qt::AlignHCenter);
+        m_ui->tableWidget->setItem(i, TC_FORCE, it_3);
     }
 }
 
@@ -72,48 +77,27 @@ OverviewDialog::~OverviewDialog()
 }
 
 
-void OverviewDialog::updateIsleInfos(QList<IsleInfo> inIsleInfos)
+void OverviewDialog::updateStats(const PlayerStats & inStats)
 {
-    QVector<int> isleCount(m_numPlayer + 2, 0);
-    QVector<int> populationCount(m_numPlayer + 2, 0);
-
-    for(IsleInfo iInfo : inIsleInfos)
-    {
-        // counting isles for player iInfo.owner
-        isleCount[iInfo.owner]++;
-        // counting isles for all player in total
-        isleCount[m_numPlayer + 1]++;
-
-        populationCount[iInfo.owner] = populationCount.value(iInfo.owner) + iInfo.population;
-        populationCount[m_numPlayer + 1] = populationCount.value(m_numPlayer + 1) + iInfo.population;
-    }
-
-    // display the infos in the table
-    for(uint i = 0; i < m_numPlayer + 2; i++)
-    {
-        QString ic = QString("%1").arg( isleCount.value(i, -1) );
-        QString pc = QString("%1").arg( populationCount.value(i, -1));
-
-        m_ui->tableWidget->item(i, TC_ISLES)->setText(ic);
-        m_ui->tableWidget->item(i, TC_POPULATION)->setText(pc);
-    }
+    const QVector<OwnerStats> & owners = inStats.owners();
+    for(uint i = 0; i <= m_numPlayer; i++)
+        showRow(i, owners.value(i));
+    showRow(m_numPlayer + 1, inStats.total());
 }
 
 
-void OverviewDialog::updateShipInfos(QList<ShipInfo> inShipInfos)
+void OverviewDialog::showRow(const int inRow, const OwnerStats & inStats)
 {
-    QVector<int> shipCount(m_numPlayer + 2, 0);
-
-    // count
-    for(ShipInfo sInfo : inShipInfos)
-    {
-        shipCount[sInfo.owner]++;
-        shipCount[m_numPlayer + 1]++;
-    }
-    // display
-    for(uint i = 0; i < m_numPlayer + 2; i++)
-    {
-        QString sc = QString("%1").arg( shipCount.value(i, -1) );
-        m_ui->tableWidget->item(i, TC_SHIPS)->setText(sc);
-    }
+    m_ui->tableWidget->item(inRow, TC_ISLES)->setText(QString::number(inStats.isles));
+    m_ui->tableWidget->item(inRow, TC_POPULATION)->setText(QString::number((int) inStats.population));
+
+    QTableWidgetItem *shipItem = m_ui->tableWidget->item(inRow, TC_SHIPS);
+    shipItem->setText(QString::number(inStats.shipCount()));
+    shipItem->setToolTip(QString("Battleships: %1\nCouriers: %2\nColony ships: %3\nFleets: %4")
+                         .arg(inStats.ships[ST_BATTLESHIP])
+                         .arg(inStats.ships[ST_COURIER])
+                         .arg(inStats.ships[ST_COLONY])
+                         .arg(inStats.ships[ST_FLEET]));
+
+    m_ui->tableWidget->item(inRow, TC_FORCE)->setText(QString::number(inStats.force, 'f', 1));
 }
@@ -8,10 +8,8 @@
 #define OVERVIEWDIALOG_H
 
 
-#include "isle.h"
-#include "ship.h"
+#include <playerstats.h>
 #include <QDialog>
-#include <QList>
 
 
 namespace Ui {
@@ -23,20 +21,22 @@ class OverviewDialog : public QDialog
 {
     Q_OBJECT
 
-    enum TableColumn {TC_ISLES = 0, TC_POPULATION = 1, TC_SHIPS = 2};
+    enum TableColumn {TC_ISLES = 0, TC_POPULATION = 1, TC_SHIPS = 2, TC_FORCE = 3};
 
 public:
     // inNumPlayer: human and computer player
     explicit OverviewDialog(const uint inNumPlayer, QWidget *inParent = 0);
     ~OverviewDialog();
 
-    void updateIsleInfos(QList<IsleInfo> inIsleInfos);
-    void updateShipInfos(QList<ShipInfo> inShipInfos);
+    // cheap enough to call every round, see UniverseSnapshot::playerStats
+    void updateStats(const PlayerStats & inStats);
 
 private:
     Ui::OverviewDialog *m_ui;
 
     uint m_numPlayer;       // number of player (human and computer)
+
+    void showRow(const int inRow, const OwnerStats & inStats);
 };
 
 
@@ -13,25 +13,6 @@ Player::Player(const uint inOwner)
 }
 
 
-QColor Player::colorForOwner(uint inOwnerId)
-{
-    switch(inOwnerId)
-    {
-        case 0: return Qt::lightGray;
-        case 1: return Qt::green;
-        case 2: return Qt::yellow;
-        case 3: return Qt::magenta;
-        case 4: return Qt::cyan;
-        case 5: return Qt::red;
-        case 6: return Qt::darkYellow;
-        case 7: return Qt::darkMagenta;
-        case 8: return Qt::darkCyan;
-        case 9: return Qt::darkRed;
-        default: return Qt::red;
-    }
-}
-
-
 QString Player::nameForOwner(uint inOwnerId)
 {
     switch(inOwnerId)
@@ -8,7 +8,6 @@
 #define PLAYER_H
 
 
-#include <QColor>
 #include <QString>
 
 
@@ -32,8 +31,6 @@ public:
 
     bool isDead() const { return m_isDead; }
 
-    static QColor colorForOwner(uint inOwnerId);
-
     static QString nameForOwner(uint inOwnerId);
 
 private:
@@ -0,0 +1,25 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+#ifndef PLAYERCOLOR_H
+#define PLAYERCOLOR_H
+
+
+#include <QColor>
+
+
+/**
+ * @brief The PlayerColor class maps owner-ids (see Player::PlayerEnum) to colors.
+ *
+ * Colors are only needed for display, so this is part of the GUI and not of Player.
+ */
+class PlayerColor
+{
+public:
+    static QColor colorForOwner(uint inOwnerId);
+};
+
+#endif // PLAYERCOLOR_H
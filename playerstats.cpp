@@ -0,0 +1,84 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+#include <playerstats.h>
+
+
+int OwnerStats::shipCount() const
+{
+    int count = 0;
+    for(int i = 0; i < NUM_SHIP_TYPES; i++)
+        count += ships[i];
+    return count;
+}
+
+
+void PlayerStats::addIsle(const uint inOwner, const float inPopulation, const float inTechnology)
+{
+    OwnerStats & stats = ownerStats(inOwner);
+    stats.isles++;
+    stats.population += inPopulation;
+    stats.technology += inTechnology;
+}
+
+
+void PlayerStats::removeIsle(const uint inOwner, const float inPopulation, const float inTechnology)
+{
+    OwnerStats & stats = ownerStats(inOwner);
+    stats.isles--;
+    stats.population -= inPopulation;
+    stats.technology -= inTechnology;
+    Q_ASSERT(stats.isles >= 0);
+    // no rounding errors left behind
+    if(stats.isles == 0)
+    {
+        stats.population = 0.0;
+        stats.technology = 0.0;
+    }
+}
+
+
+void PlayerStats::addShip(const uint inOwner, const ShipTypeEnum inShipType, const float inForce)
+{
+    OwnerStats & stats = ownerStats(inOwner);
+    stats.ships[inShipType]++;
+    stats.force += inForce;
+}
+
+
+void PlayerStats::removeShip(const uint inOwner, const ShipTypeEnum inShipType, const float inForce)
+{
+    OwnerStats & stats = ownerStats(inOwner);
+    stats.ships[inShipType]--;
+    stats.force -= inForce;
+    Q_ASSERT(stats.ships[inShipType] >= 0);
+    if(stats.shipCount() == 0)
+        stats.force = 0.0;
+}
+
+
+OwnerStats PlayerStats::total() const
+{
+    OwnerStats sum;
+    for(const OwnerStats & stats : m_owners)
+    {
+        sum.isles += stats.isles;
+        sum.population += stats.population;
+        sum.technology += stats.technology;
+        for(int i = 0; i < OwnerStats::NUM_SHIP_TYPES; i++)
+            sum.ships[i] += stats.ships[i];
+        sum.force += stats.force;
+    }
+    return sum;
+}
+
+
+OwnerStats & PlayerStats::ownerStats(const uint inOwner)
+{
+    if((int) inOwner >= m_owners.count())
+        m_owners.resize(inOwner + 1);
+    return m_owners[inOwner];
+}
@@ -0,0 +1,65 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+#ifndef PLAYERSTATS_H
+#define PLAYERSTATS_H
+
+
+#include <ship.h>
+#include <QVector>
+
+
+// everything one owner has. Ships in fleets count through their fleet
+struct OwnerStats
+{
+    static const int NUM_SHIP_TYPES = ST_FLEET + 1;
+
+    int isles;
+    double population;
+    double technology;          // sum over all isles
+    int ships[NUM_SHIP_TYPES];  // by ShipTypeEnum
+    double force;               // of all ships
+
+    OwnerStats() : isles(0), population(0.0), technology(0.0), force(0.0)
+    {
+        for(int i = 0; i < NUM_SHIP_TYPES; i++)
+            ships[i] = 0;
+    }
+
+    int shipCount() const;
+};
+
+
+/**
+ * @brief The PlayerStats class sums up isles, population, technology, ships and force per owner
+ *
+ * Isles and ships keep it up to date by themselves: they remember, what they added
+ * and take it back before they add their new values (see Isle::updateStats() and
+ * Ship::updateStats()). So reading the stats costs O(players), not O(objects).
+ */
+class PlayerStats
+{
+public:
+    void addIsle(const uint inOwner, const float inPopulation, const float inTechnology);
+    void removeIsle(const uint inOwner, const float inPopulation, const float inTechnology);
+
+    void addShip(const uint inOwner, const ShipTypeEnum inShipType, const float inForce);
+    void removeShip(const uint inOwner, const ShipTypeEnum inShipType, const float inForce);
+
+    // index is the owner, owners without anything may be missing at the end
+    const QVector<OwnerStats> & owners() const { return m_owners; }
+
+    // all owners together
+    OwnerStats total() const;
+
+private:
+    // grows on demand
+    OwnerStats & ownerStats(const uint inOwner);
+
+    QVector<OwnerStats> m_owners;
+};
+
+#endif // PLAYERSTATS_H
@@ -0,0 +1,39 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+#include <pursuerindex.h>
+
+
+PursuerIndex::PursuerIndex()
+{
+}
+
+
+void PursuerIndex::addPursuit(const uint inTargetShipId, Ship *inPursuer)
+{
+    m_pursuers[inTargetShipId].append(inPursuer);
+}
+
+
+void PursuerIndex::removePursuit(const uint inTargetShipId, Ship *inPursuer)
+{
+    QHash<uint, QVector<Ship*> >::iterator it = m_pursuers.find(inTargetShipId);
+    if(it == m_pursuers.end())
+        return;
+    QVector<Ship*> & pursuers = it.value();
+    for(int i = 0; i < pursuers.count(); i++)
+    {
+        if(pursuers.at(i) == inPursuer)
+        {
+            // order does not matter, so move the last one here
+            pursuers[i] = pursuers.last();
+            pursuers.removeLast();
+            break;
+        }
+    }
+    if(pursuers.isEmpty())
+        m_pursuers.erase(it);
+}
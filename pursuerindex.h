@@ -0,0 +1,48 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+#ifndef PURSUERINDEX_H
+#define PURSUERINDEX_H
+
+
+#include <QHash>
+#include <QVector>
+
+
+class Ship;
+
+
+/**
+ * @brief The PursuerIndex class knows, which ships have another ship as a target (T_SHIP)
+ *
+ * It is the reverse of Ship::targets() for ship targets: for a target ship id, it
+ * returns all pursuers. Ships keep this index up to date whenever they add or remove
+ * a ship target, so Universe does not need to look at every ship's target list.
+ *
+ * A ship may have the same target ship more than once in its target list, then it
+ * appears more than once as a pursuer.
+ */
+class PursuerIndex
+{
+public:
+    PursuerIndex();
+
+    void addPursuit(const uint inTargetShipId, Ship *inPursuer);
+
+    // removes one pursuit of inPursuer
+    void removePursuit(const uint inTargetShipId, Ship *inPursuer);
+
+    // every ship, which has inTargetShipId as a target
+    QVector<Ship*> pursuers(const uint inTargetShipId) const { return m_pursuers.value(inTargetShipId); }
+
+    // target ship id -> pursuers, for all ships which are targets
+    const QHash<uint, QVector<Ship*> > & allPursuits() const { return m_pursuers; }
+
+private:
+    QHash<uint, QVector<Ship*> > m_pursuers;
+};
+
+#endif // PURSUERINDEX_H
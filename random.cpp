@@ -0,0 +1,53 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+#include <random.h>
+
+#include <QDateTime>
+
+
+static const quint64 PCG_MULTIPLIER = Q_UINT64_C(6364136223846793005);
+static const quint64 PCG_INCREMENT = Q_UINT64_C(1442695040888963407);
+
+
+Random::Random(const quint64 inSeed)
+    : m_seed(inSeed), m_state(0)
+{
+    // seeding as in pcg32_srandom_r()
+    next();
+    m_state += inSeed;
+    next();
+}
+
+
+quint32 Random::next()
+{
+    quint64 oldState = m_state;
+    m_state = oldState * PCG_MULTIPLIER + PCG_INCREMENT;
+    quint32 xorShifted = (quint32) (((oldState >> 18u) ^ oldState) >> 27u);
+    quint32 rot = (quint32) (oldState >> 59u);
+    return (xorShifted >> rot) | (xorShifted << ((32u - rot) & 31u));
+}
+
+
+quint32 Random::bounded(const quint32 inBound)
+{
+    Q_ASSERT(inBound > 0);
+    // drop the few numbers at the top, which would favour small results
+    quint32 threshold = (0u - inBound) % inBound;
+    for(;;)
+    {
+        quint32 r = next();
+        if(r >= threshold)
+            return r % inBound;
+    }
+}
+
+
+quint64 Random::seedFromClock()
+{
+    return (quint64) QDateTime::currentMSecsSinceEpoch();
+}
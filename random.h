@@ -0,0 +1,42 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+#ifndef RANDOM_H
+#define RANDOM_H
+
+
+#include <QtGlobal>
+
+
+/**
+ * @brief The Random class is a small PCG32 random number generator
+ *
+ * Same seed, same numbers, on every platform and with every compiler. Unlike rand(),
+ * it keeps no global state, so a universe can be rebuilt from its seed.
+ * See http://www.pcg-random.org for the algorithm (PCG-XSH-RR 64/32).
+ */
+class Random
+{
+public:
+    explicit Random(const quint64 inSeed);
+
+    quint64 seed() const { return m_seed; }
+
+    // next 32 random bits
+    quint32 next();
+
+    // equally distributed number in [0, inBound), inBound must be > 0
+    quint32 bounded(const quint32 inBound);
+
+    // a seed, if the user doesn't give us one
+    static quint64 seedFromClock();
+
+private:
+    quint64 m_seed;
+    quint64 m_state;
+};
+
+#endif // RANDOM_H
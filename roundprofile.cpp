@@ -0,0 +1,56 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+#include <roundprofile.h>
+
+
+const char* RoundProfile::phaseName(const PhaseEnum inPhase)
+{
+    switch(inPhase)
+    {
+        case PH_PREPARE_STRATEGIES: return "prepare_strategies";
+        case PH_STRATEGIES: return "strategies";
+        case PH_ISLES: return "isles";
+        case PH_SHIPS: return "ships";
+        case PH_CLEANUP: return "cleanup";
+        default: return "unknown";
+    }
+}
+
+
+const char* RoundProfile::counterName(const CounterEnum inCounter)
+{
+    switch(inCounter)
+    {
+        case CT_ARRIVALS: return "arrivals";
+        case CT_FIGHTS: return "fights";
+        case CT_CAPTURES: return "captures";
+        case CT_DELETIONS: return "deletions";
+        case CT_LOOKUPS: return "lookups";
+        default: return "unknown";
+    }
+}
+
+
+bool RoundProfile::compiledIn()
+{
+#ifndef WATERWORLD_NO_PROFILE
+    return true;
+#else
+    return false;
+#endif
+}
+
+
+QString RoundProfile::toString() const
+{
+    QString s;
+    for(int i = 0; i < PH_COUNT; i++)
+        s += QString("%1=%2 ").arg(phaseName((PhaseEnum) i)).arg(phaseNs[i]);
+    for(int i = 0; i < CT_COUNT; i++)
+        s += QString("%1=%2 ").arg(counterName((CounterEnum) i)).arg(counters[i]);
+    return s.trimmed();
+}
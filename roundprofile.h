@@ -0,0 +1,101 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+#ifndef ROUNDPROFILE_H
+#define ROUNDPROFILE_H
+
+
+#include <QtGlobal>
+#include <QString>
+#include <QElapsedTimer>
+
+
+/**
+ * @brief The RoundProfile struct tells, how long each phase of Universe::nextRound() took
+ * and how often the expensive things happened.
+ *
+ * Universe fills it with the WW_PROFILE_* macros below. Build with
+ * "qmake CONFIG+=noprofile" and the macros compile to nothing, the profile stays empty.
+ */
+struct RoundProfile
+{
+    enum PhaseEnum {PH_PREPARE_STRATEGIES = 0,  // delta feed to computer players
+                    PH_STRATEGIES,              // computer players think and move
+                    PH_ISLES,                   // isles grow and build ships
+                    PH_SHIPS,                   // movement, arrivals and fights
+                    PH_CLEANUP,                 // trash and target positions
+                    PH_COUNT};
+
+    enum CounterEnum {CT_ARRIVALS = 0,          // ships which reached their target
+                      CT_FIGHTS,                // ship vs. ship and ship vs. isle
+                      CT_CAPTURES,              // isles which got a new owner by a ship
+                      CT_DELETIONS,             // ships removed from the universe
+                      CT_LOOKUPS,               // id -> isle or ship lookups
+                      CT_COUNT};
+
+    qint64 phaseNs[PH_COUNT];
+    qint64 counters[CT_COUNT];
+
+    RoundProfile() { clear(); }
+
+    void clear()
+    {
+        for(int i = 0; i < PH_COUNT; i++)
+            phaseNs[i] = 0;
+        for(int i = 0; i < CT_COUNT; i++)
+            counters[i] = 0;
+    }
+
+    qint64 totalNs() const
+    {
+        qint64 sum = 0;
+        for(int i = 0; i < PH_COUNT; i++)
+            sum += phaseNs[i];
+        return sum;
+    }
+
+    // short names, usable as keys in reports
+    static const char* phaseName(const PhaseEnum inPhase);
+    static const char* counterName(const CounterEnum inCounter);
+
+    // false, if the core was built with WATERWORLD_NO_PROFILE
+    static bool compiledIn();
+
+    // one line "phase=ns ... counter=n ...", for logging each round
+    QString toString() const;
+
+    /**
+     * @brief The ScopedTimer class adds the time between construction and destruction to a phase
+     */
+    class ScopedTimer
+    {
+    public:
+        ScopedTimer(RoundProfile & inOutProfile, const PhaseEnum inPhase)
+            : m_profile(inOutProfile), m_phase(inPhase) { m_timer.start(); }
+        ~ScopedTimer() { m_profile.phaseNs[m_phase] += m_timer.nsecsElapsed(); }
+
+    private:
+        Q_DISABLE_COPY(ScopedTimer)
+        RoundProfile & m_profile;
+        const PhaseEnum m_phase;
+        QElapsedTimer m_timer;
+    };
+};
+
+
+#ifndef WATERWORLD_NO_PROFILE
+// time the rest of the enclosing scope, one per scope
+#define WW_PROFILE_PHASE(profile, phase) RoundProfile::ScopedTimer wwPhaseTimer((profile), RoundProfile::phase)
+#define WW_PROFILE_COUNT(profile, counter, n) ((profile).counters[RoundProfile::counter] += (n))
+// one line with all phases and counters
+#define WW_PROFILE_PRINT(profile) qInfo("%s", qPrintable((profile).toString()))
+#else
+#define WW_PROFILE_PHASE(profile, phase) do {} while(0)
+#define WW_PROFILE_COUNT(profile, counter, n) do {} while(0)
+#define WW_PROFILE_PRINT(profile) do {} while(0)
+#endif
+
+#endif // ROUNDPROFILE_H
@@ -5,44 +5,81 @@
 
 
 #include <ship.h>
-#include <player.h>
+#include <worldindex.h>
+#include <isle.h>
+#include <shippool.h>
 
-#include <QBrush>
 #include <QDebug>
 
 
-Ship::Ship(UniverseScene *& inOutRefScene, const uint inId, const uint inOwner,
-           const QPointF inPos, const QColor inColor, const ShipPositionEnum inPosType,
+// memory for all ships, 256 ships per slab
+static ShipPool & shipPool()
+{
+    static ShipPool pool(sizeof(Ship), 256);
+    return pool;
+}
+
+
+void* Ship::operator new(size_t inSize)
+{
+    // subclasses would be bigger than a pool block
+    if(inSize != sizeof(Ship))
+        return ::operator new(inSize);
+    return shipPool().allocate();
+}
+
+
+void Ship::operator delete(void *inShip, size_t inSize)
+{
+    if(inSize != sizeof(Ship))
+        ::operator delete(inShip);
+    else
+        shipPool().release(inShip);
+}
+
+
+Ship::Ship(WorldIndex *inWorldIndex, const uint inId, const uint inOwner,
+           const QPointF inPos, const ShipPositionEnum inPosType,
            const uint inIsleId, const float inTechnology)
-    : Ship(inOutRefScene, ShipTypeEnum::ST_BATTLESHIP, inId,
-           inOwner, inPos, inColor, inPosType, inIsleId, inTechnology)
+    : Ship(inWorldIndex, ShipTypeEnum::ST_BATTLESHIP, inId,
+           inOwner, inPos, inPosType, inIsleId, inTechnology)
 {
 }
 
 
-Ship::Ship(UniverseScene *& inOutRefScene, const ShipTypeEnum inShipType, const uint inId, const uint inOwner,
-           const QPointF inPos, const QColor inColor, const ShipPositionEnum inPosType,
+Ship::Ship(WorldIndex *inWorldIndex, const ShipTypeEnum inShipType, const uint inId, const uint inOwner,
+           const QPointF inPos, const ShipPositionEnum inPosType,
            const uint inIsleId, const float inTechnology)
-    :  WaterObject(inId, inOwner, inPos, inColor, inTechnology),
-      m_shipType(inShipType), m_positionType(inPosType), m_onIsleById(inIsleId),
-      m_damage(0.0f), m_carryTechnology(0.0f), m_cycleTargetList(false), m_currentTargetIndex(-1)
-{
-    m_shape = new QGraphicsRectItem(-7.0f, -7.0f, 14.0f, 14.0f);
-    m_shape->setPos(inPos.x(), inPos.y());
-    m_shape->hide();
-    inOutRefScene->addItem(m_shape);
-    m_shape->setBrush(QBrush(inColor));
+    :  WaterObject(inId, inOwner, inPos, inTechnology),
+      m_worldIndex(inWorldIndex), m_shipType(inShipType), m_positionType(inPosType), m_onIsleById(inIsleId),
+      m_damage(0.0f), m_carryTechnology(0.0f), m_cycleTargetList(false), m_currentTargetIndex(-1),
+      m_garrison(0), m_garrisonPrev(0), m_garrisonNext(0), m_kinematicsSlot(-1),
+      m_statsCounted(false), m_statsOwner(inOwner), m_statsForce(0.0f)
+{
     setCarryTechnology(inTechnology);   // for ST_COURIER
     m_fleetId = 0;                      // not part of fleet
+    m_worldIndex->shipGrid.insert(m_id, m_pos);
+    updateGarrison();
+    updateWorldIndex();
 }
 
 
 Ship::~Ship()
 {
     if(m_shipType == ShipTypeEnum::ST_FLEET)
+    {
         for(Ship * &s : m_fleetShips)
             delete s;
-    delete m_shape;
+        m_fleetShips.clear();
+    }
+    // nobody should think, we are still pursuing someone
+    removeTargets();
+    m_worldIndex->shipGrid.remove(m_id, m_pos);
+    if(m_garrison)
+        m_garrison->remove(this);
+    if(m_statsCounted)
+        m_worldIndex->stats.removeShip(m_statsOwner, m_shipType, m_statsForce);
+    m_worldIndex->changes.shipDestroyed(m_id);
 }
 
 
@@ -81,7 +118,6 @@ ShipInfo Ship::info() const
     outInfo.id = m_id;
     outInfo.shipType = m_shipType;
     outInfo.owner = m_owner;
-    outInfo.color = m_color;
     outInfo.pos = m_pos;
     outInfo.posType = m_positionType;
     outInfo.isleId = m_onIsleById;
@@ -104,27 +140,75 @@ ShipInfo Ship::info() const
 }
 
 
-void Ship::setOwner(const uint inOwner, const QColor inColor)
+void Ship::setOwner(const uint inOwner)
 {
     m_owner = inOwner;
-    m_color = inColor;
-    m_shape->setBrush(QBrush(Player::colorForOwner(inOwner)));
     removeTargets();
     m_cycleTargetList = false;
+    updateWorldIndex();
     // if this is a fleet, do the same for all members
     if(m_shipType == ShipTypeEnum::ST_FLEET)
         for(Ship *s : m_fleetShips)
-            s->setOwner(inOwner, inColor);
+            s->setOwner(inOwner);
 }
 
 
 void Ship::setPositionType(ShipPositionEnum inType)
 {
-    if(inType == ShipPositionEnum::SP_OCEAN)
-        m_shape->show();
-    else
-        m_shape->hide();
     m_positionType = inType;
+    updateGarrison();
+    updateWorldIndex();
+}
+
+
+void Ship::updateGarrison()
+{
+    GarrisonList *garrison = 0;
+    if(m_positionType == ShipPositionEnum::SP_ONISLE or
+       m_positionType == ShipPositionEnum::SP_PATROL)
+    {
+        Isle *isle = m_worldIndex->isle(m_onIsleById);
+        if(isle)
+            garrison = (m_positionType == ShipPositionEnum::SP_ONISLE) ?
+                        &isle->shipsOnIsle() : &isle->patrolShips();
+    }
+    if(garrison == m_garrison)
+        return;
+    if(m_garrison)
+        m_garrison->remove(this);
+    if(garrison)
+        garrison->append(this);
+}
+
+
+void Ship::updateWorldIndex()
+{
+    bool sails = m_currentTargetIndex >= 0 and m_currentTargetIndex < m_targetList.count() and
+            m_positionType != ShipPositionEnum::SP_TRASH and
+            m_positionType != ShipPositionEnum::SP_IN_FLEET;
+    if(sails)
+        m_worldIndex->kinematics.set(this, m_pos, m_targetList.at(m_currentTargetIndex).pos, m_technology);
+    else if(m_kinematicsSlot >= 0)
+        m_worldIndex->kinematics.remove(this);
+    m_worldIndex->changes.shipChanged(m_id);
+    updateStats();
+}
+
+
+void Ship::updateStats()
+{
+    // fleet members are counted by their fleet
+    bool counts = m_positionType != ShipPositionEnum::SP_TRASH and
+            m_positionType != ShipPositionEnum::SP_IN_FLEET;
+    if(m_statsCounted)
+        m_worldIndex->stats.removeShip(m_statsOwner, m_shipType, m_statsForce);
+    m_statsCounted = counts;
+    if(counts)
+    {
+        m_statsOwner = m_owner;
+        m_statsForce = force();
+        m_worldIndex->stats.addShip(m_statsOwner, m_shipType, m_statsForce);
+    }
 }
 
 
@@ -132,7 +216,10 @@ void Ship::setCarryTechnology(const float inTechlevel)
 {
     // courier ships taking the maximum
     if( (m_shipType == ShipTypeEnum::ST_COURIER) and (inTechlevel > m_carryTechnology))
+    {
         m_carryTechnology = inTechlevel;
+        updateWorldIndex();
+    }
     // @fixme: fleets may contain a courier
 }
 
@@ -140,6 +227,7 @@ void Ship::setCarryTechnology(const float inTechlevel)
 void Ship::setCycleTargets(const bool inCycleTarget)
 {
     m_cycleTargetList = inCycleTarget;
+    updateWorldIndex();
 }
 
 
@@ -167,6 +255,7 @@ void Ship::setTargetShip(const uint inTargetShipId, const QPointF inPos)
         t.tType = Target::TargetEnum::T_SHIP;
         t.visited = false;
         m_targetList.append(t);
+        m_worldIndex->pursuers.addPursuit(inTargetShipId, this);
         fixTargetIndex();
     }
 }
@@ -174,6 +263,8 @@ void Ship::setTargetShip(const uint inTargetShipId, const QPointF inPos)
 
 void Ship::removeTargets()
 {
+    for(const Target & t : m_targetList)
+        forgetTarget(t);
     m_targetList.clear();
     fixTargetIndex();
 }
@@ -186,6 +277,7 @@ void Ship::removeTargetShip(const uint inShipId)
         Target t = m_targetList.at(idx);
         if(t.tType == Target::T_SHIP and t.id == inShipId)
         {
+            forgetTarget(t);
             m_targetList.removeAt(idx);
         }
     }
@@ -199,6 +291,7 @@ void Ship::removeTargetByIndex(const int inIndex)
         return;
     if(inIndex >= m_targetList.count())
         return;
+    forgetTarget(m_targetList.at(inIndex));
     m_targetList.remove(inIndex);
     fixTargetIndex();
 }
@@ -240,6 +333,7 @@ void Ship::setTargetFinished()
             }
         }
     }
+    updateWorldIndex();
 }
 
 
@@ -248,6 +342,7 @@ void Ship::updateTargetPos(const uint inShipId, const QPointF inPos)
     for(Target & t : m_targetList)
         if(t.tType == Target::T_SHIP and t.id == inShipId)
             t.pos = inPos;
+    updateWorldIndex();
 }
 
 
@@ -255,42 +350,11 @@ void Ship::landOnIsle(const uint inIsleId, const QPointF inPos)
 {
     m_onIsleById = inIsleId;
     setPositionType(ShipPositionEnum::SP_ONISLE);
-    m_pos = inPos;
+    moveTo(inPos);
     setTargetFinished();
 }
 
 
-bool Ship::nextRound()
-{
-    if(m_positionType == ShipPositionEnum::SP_TRASH or
-       m_positionType == ShipPositionEnum::SP_IN_FLEET)
-    {
-        return false;    // we don't care, because universe/fleet does
-    }
-
-    if(m_targetList.count() == 0)
-        return false;
-
-    // Rod_Steward::Sailing, YouTube::DyIw0gcgfik
-    Target currentTarget = m_targetList[m_currentTargetIndex];
-    setPositionType(ShipPositionEnum::SP_OCEAN);
-    float dx = currentTarget.pos.x() - m_pos.x();
-    float dy = currentTarget.pos.y() - m_pos.y();
-
-    float d = sqrt( dx * dx + dy * dy );
-
-    if(d <= m_technology)
-        return true;
-
-    float ex = dx / d;
-    float ey = dy / d;
-
-    m_pos = QPointF{m_pos.x() + m_technology * ex, m_pos.y() + m_technology * ey};
-    m_shape->setPos(m_pos);
-    return false;
-}
-
-
 float Ship::force() const
 {
     if(isDead())
@@ -313,6 +377,7 @@ void Ship::takeDamage(const float inOpponentForce)
     if(m_shipType == ShipTypeEnum::ST_BATTLESHIP)
     {
         m_damage  =  m_damage  + inOpponentForce/m_technology;
+        updateWorldIndex();
         if(m_damage < 0.99f)
             return;
     }
@@ -382,6 +447,7 @@ void Ship::repair()
         m_damage = m_damage - 0.05;
         if(m_damage < 0)
             m_damage = 0.0;
+        updateWorldIndex();
     }
 }
 
@@ -391,10 +457,10 @@ bool Ship::pointInShip(const QPointF inPos)
     if(m_positionType != ShipPositionEnum::SP_OCEAN)
         return false;
     QPointF myPos = pos();
-    return inPos.x() > (myPos.x() - 7.0f) and
-            inPos.x() < (myPos.x() + 7.0f) and
-            inPos.y() > (myPos.y() - 7.0f) and
-            inPos.y() < (myPos.y() + 7.0f);
+    return inPos.x() > (myPos.x() - HALF_WIDTH) and
+            inPos.x() < (myPos.x() + HALF_WIDTH) and
+            inPos.y() > (myPos.y() - HALF_WIDTH) and
+            inPos.y() < (myPos.y() + HALF_WIDTH);
 }
 
 
@@ -428,6 +494,7 @@ void Ship::fixTargetIndex()
         // stop the engines
         m_cycleTargetList = false;
         m_currentTargetIndex = -1;
+        updateWorldIndex();
         return;
     }
 
@@ -438,6 +505,7 @@ void Ship::fixTargetIndex()
         if(! t.visited)
         {
             m_currentTargetIndex = i;
+            updateWorldIndex();
             return;
         }
     }
@@ -448,6 +516,7 @@ void Ship::fixTargetIndex()
         m_currentTargetIndex = 0;
         for(Target & t : m_targetList)
             t.visited = false;
+        updateWorldIndex();
         return;
     }
 
@@ -456,6 +525,29 @@ void Ship::fixTargetIndex()
 }
 
 
+void Ship::forgetTarget(const Target & t)
+{
+    if(t.tType == Target::T_SHIP)
+        m_worldIndex->pursuers.removePursuit(t.id, this);
+}
+
+
+void Ship::moveTo(const QPointF inPos)
+{
+    m_worldIndex->shipGrid.move(m_id, m_pos, inPos);
+    m_pos = inPos;
+    updateWorldIndex();
+}
+
+
+void Ship::sailedTo(const QPointF inPos)
+{
+    m_worldIndex->shipGrid.move(m_id, m_pos, inPos);
+    m_pos = inPos;
+    m_worldIndex->changes.shipChanged(m_id);
+}
+
+
 void Ship::addCurrentPosToTarget()
 {
     // only add current pos to empty targets
@@ -532,6 +624,7 @@ void Ship::addToFleet(const uint inFleetId)
         return;
     setPositionType(ShipPositionEnum::SP_IN_FLEET);
     m_fleetId = inFleetId;
+    updateWorldIndex();
 }
 
 
@@ -539,11 +632,11 @@ void Ship::removeFromFleet(const ShipInfo inFleetInfo)
 {
     if(m_positionType == ShipPositionEnum::SP_TRASH)
         return;
-    setPositionType(inFleetInfo.posType);
     m_onIsleById = inFleetInfo.isleId;
+    setPositionType(inFleetInfo.posType);
     m_carryTechnology = inFleetInfo.carryTechnology;
-    m_pos = inFleetInfo.pos;
     m_fleetId = 0;
+    moveTo(inFleetInfo.pos);
 }
 
 
@@ -583,6 +676,7 @@ void Ship::updateFleet()
     }
     m_technology = maxTech;
     m_damage = damage / techlevel;
+    updateWorldIndex();     // speed may have changed
 
     if(m_damage >= 0.99f or m_fleetShips.count() == 0)
         setPositionType(ShipPositionEnum::SP_TRASH);
@@ -9,12 +9,17 @@
 
 
 #include <waterobject.h>
-#include <universescene.h>
-#include <QGraphicsRectItem>
 #include <QPointF>
-#include <QColor>
+#include <QString>
+#include <QVector>
+#include <QMetaType>
 #include <math.h>
 
+
+class WorldIndex;
+class GarrisonList;
+
+
 struct Target
 {
     // targets can be ships, isles and just a place on the water.
@@ -44,7 +49,6 @@ struct ShipInfo
     uint id;
     ShipTypeEnum shipType;
     uint owner;
-    QColor color;
     QPointF pos;
     ShipPositionEnum posType;
     uint isleId;            // if not on ocean
@@ -62,35 +66,45 @@ struct ShipInfo
 class Ship : public WaterObject
 {
 public:
-    Ship(UniverseScene *& inOutRefScene, const uint inId, const uint inOwner,
-         const QPointF inPos, const QColor inColor, const ShipPositionEnum inPosType,
+    // ships are squares, 2 * HALF_WIDTH wide
+    static constexpr float HALF_WIDTH = 7.0f;
+
+    /* inWorldIndex is shared by all ships of a universe. Whenever a ship adds
+     * or removes a target ship or moves, it tells the index. */
+    Ship(WorldIndex *inWorldIndex, const uint inId, const uint inOwner,
+         const QPointF inPos, const ShipPositionEnum inPosType,
          const uint inIsleId, const float inTechnology);
 
-    Ship(UniverseScene *& inOutRefScene, const ShipTypeEnum inShipType, const uint inId, const uint inOwner,
-         const QPointF inPos, const QColor inColor, const ShipPositionEnum inPosType,
+    Ship(WorldIndex *inWorldIndex, const ShipTypeEnum inShipType, const uint inId, const uint inOwner,
+         const QPointF inPos, const ShipPositionEnum inPosType,
          const uint inIsleId, const float inTechnology);
 
     virtual ~Ship();
 
+    // ships come from a ShipPool, see shippool.h
+    static void* operator new(size_t inSize);
+    static void operator delete(void *inShip, size_t inSize);
+
     void debugReport();
 
     // getter
 
     static QString shipTypeName(const ShipTypeEnum inShipType);
 
-    QGraphicsRectItem* shape() const { return m_shape; }
-
     ShipInfo info() const;
 
     ShipPositionEnum positionType() const { return m_positionType; }
 
+    // next ship in the same isle garrison, see Isle::shipsOnIsle() and Isle::patrolShips()
+    Ship* nextInGarrison() const { return m_garrisonNext; }
+
     // setter
 
     /**
       * @brief Sets the new owner of the ship
       *
       */
-    void setOwner(const uint inOwner, const QColor inColor);
+    void setOwner(const uint inOwner);
 
     void setPositionType(ShipPositionEnum inType);
 
@@ -133,8 +147,6 @@ public:
 
     void addDamage(const float inDamageToAdd);
 
-    bool nextRound();
-
     // all about fighting, damage and repair
     float force() const;
     void takeDamage(const float inOpponentForce);
@@ -194,12 +206,14 @@ public:
 
 
 private:
+    friend class GarrisonList;
+    friend class ShipKinematics;
+
+    WorldIndex *m_worldIndex;
     ShipTypeEnum m_shipType;
-    QGraphicsRectItem *m_shape;
     ShipPositionEnum m_positionType;
     uint m_onIsleById;
     float m_damage;         // sailing arround, patroling, and fighting increases damage. Repair on isle,
-    float m_halfWidth;
     float m_carryTechnology;
 
     // all about targets
@@ -210,6 +224,39 @@ private:
     // after inserting / removing targets, m_currentTargetIndex and m_cycleTargetList need to get fixed
     void fixTargetIndex();
 
+    // tell the pursuer index, that target t gets removed from m_targetList
+    void forgetTarget(const Target & t);
+
+    // set m_pos and keep the ship grid and kinematics up to date
+    void moveTo(const QPointF inPos);
+
+    // ShipKinematics::step() moved us to inPos: set m_pos, keep the ship grid up to date and
+    // tell the change feed. Our kinematics slot holds inPos already, position type is unchanged
+    void sailedTo(const QPointF inPos);
+
+    // garrison membership, only if we are SP_ONISLE or SP_PATROL
+    GarrisonList *m_garrison;
+    Ship *m_garrisonPrev;
+    Ship *m_garrisonNext;
+
+    // join or leave the garrison lists of our isle after m_positionType or m_onIsleById changed
+    void updateGarrison();
+
+    // our slot in WorldIndex::kinematics or -1, if we don't sail
+    int m_kinematicsSlot;
+
+    /* tell the world index, that something changed: the kinematics need position,
+     * current target, speed and position type, the change feed just our id */
+    void updateWorldIndex();
+
+    // move our ship count and force in m_worldIndex->stats to the current values
+    void updateStats();
+
+    // what we have added to m_worldIndex->stats, see updateStats()
+    bool m_statsCounted;
+    uint m_statsOwner;
+    float m_statsForce;
+
     /* add the current pos as a visted target in
      * case there are no targets, this shows up a better path
      */
@@ -222,4 +269,10 @@ private:
 
 };
 
+
+// these travel in queued signals between the simulation thread and the GUI
+Q_DECLARE_METATYPE(Target)
+Q_DECLARE_METATYPE(ShipTypeEnum)
+Q_DECLARE_METATYPE(ShipInfo)
+
 #endif // SHIP_H
@@ -0,0 +1,278 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+#include <shipbatchitem.h>
+#include <playercolor.h>
+#include <ship.h>
+
+#include <math.h>
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+
+
+const int ShipBatchItem::DENSITY_TIERS[ShipBatchItem::NUM_DENSITY_TIERS] = {16, 64, 256};
+
+
+ShipBatchItem::ShipBatchItem(QGraphicsItem *inParent)
+    : QGraphicsItem(inParent), m_pen(Qt::black), m_lastOrdered(true), m_ordered(true), m_paintedTier(-1)
+{
+    // paint() needs the exposed rect for culling
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
+    for(int tier = 0; tier < NUM_DENSITY_TIERS; tier++)
+        m_densityCounted[tier] = false;
+}
+
+
+void ShipBatchItem::beginUpdate()
+{
+    for(OwnerShips & owner : m_owners)
+        owner.rects.resize(0);
+    m_centers.resize(0);
+    m_centerOwners.resize(0);
+    m_nextBounds = QRectF();
+    m_lastShips.swap(m_ships);
+    m_ships.resize(0);
+    m_lastOrdered = m_ordered;
+    m_ordered = true;
+}
+
+
+void ShipBatchItem::addShip(const uint inShipId, const uint inOwner, const QPointF inPos)
+{
+    // same size as the single ship items had
+    const qreal halfWidth = Ship::HALF_WIDTH;
+    QRectF rect(inPos.x() - halfWidth, inPos.y() - halfWidth, 2.0 * halfWidth, 2.0 * halfWidth);
+    const int slot = ownerSlot(inOwner);
+    m_owners[slot].rects.append(rect);
+    m_centers.append(inPos);
+    m_centerOwners.append(slot);
+
+    if(not m_ships.isEmpty() and m_ships.last().id >= inShipId)
+        m_ordered = false;
+    ShipRect ship;
+    ship.id = inShipId;
+    ship.rect = rect;
+    m_ships.append(ship);
+    // the outline is half outside of the rect
+    const qreal penMargin = m_pen.widthF() / 2.0;
+    QRectF outer = rect.adjusted(-penMargin, -penMargin, penMargin, penMargin);
+    m_nextBounds = m_nextBounds.isNull() ? outer : m_nextBounds.united(outer);
+}
+
+
+void ShipBatchItem::endUpdate()
+{
+    // counted again by the next paint(), which needs them
+    for(int tier = 0; tier < NUM_DENSITY_TIERS; tier++)
+        m_densityCounted[tier] = false;
+
+    // rects, which look different now: old and new place of moved ships, new and gone ships.
+    // Both lists are ordered by id, so one walk through both finds them
+    QVector<QRectF> & dirty = m_dirtyRects;
+    dirty.resize(0);
+    // zoomed out, a ship changes a whole cell. The view is small then, repaint all of it
+    bool tooMany = not (m_ordered and m_lastOrdered) or m_paintedTier >= 0;
+    int current = 0;
+    int last = 0;
+    while(not tooMany and (current < m_ships.count() or last < m_lastShips.count()))
+    {
+        if(last == m_lastShips.count() or
+                (current < m_ships.count() and m_ships.at(current).id < m_lastShips.at(last).id))
+            dirty.append(m_ships.at(current++).rect);       // new ship
+        else if(current == m_ships.count() or m_lastShips.at(last).id < m_ships.at(current).id)
+            dirty.append(m_lastShips.at(last++).rect);      // gone
+        else
+        {
+            if(m_ships.at(current).rect != m_lastShips.at(last).rect)
+            {   // moved
+                dirty.append(m_lastShips.at(last).rect);
+                dirty.append(m_ships.at(current).rect);
+            }
+            current++;
+            last++;
+        }
+        tooMany = dirty.count() > MAX_DIRTY_RECTS;
+    }
+
+    const QRectF oldBounds = m_densityBounds;
+    if(m_nextBounds != m_bounds)
+    {
+        m_bounds = m_nextBounds;
+        const QRectF bounds = densityBounds(m_bounds);
+        if(bounds != m_densityBounds)
+        {
+            prepareGeometryChange();
+            m_densityBounds = bounds;
+        }
+    }
+
+    const qreal penMargin = m_pen.widthF() / 2.0;
+    if(tooMany)
+    {   // most of the ships moved, one rect is cheaper than many small ones
+        update(oldBounds);
+        update();
+    }
+    else
+        for(const QRectF & rect : dirty)
+            update(rect.adjusted(-penMargin, -penMargin, penMargin, penMargin));
+}
+
+
+QRectF ShipBatchItem::boundingRect() const
+{
+    return m_densityBounds;
+}
+
+
+QRectF ShipBatchItem::densityBounds(const QRectF & inBounds)
+{
+    if(inBounds.isNull())
+        return QRectF();
+    // the same grid as countDensity(). The smaller tiers divide the largest one
+    const qreal size = DENSITY_TIERS[NUM_DENSITY_TIERS - 1];
+    const qreal left = floor(inBounds.left() / size) * size;
+    const qreal top = floor(inBounds.top() / size) * size;
+    const qreal right = (floor(inBounds.right() / size) + 1.0) * size;
+    const qreal bottom = (floor(inBounds.bottom() / size) + 1.0) * size;
+    return QRectF(left, top, right - left, bottom - top);
+}
+
+
+void ShipBatchItem::paint(QPainter *inPainter, const QStyleOptionGraphicsItem *inOption, QWidget *inWidget)
+{
+    Q_UNUSED(inWidget);
+    if(m_ships.isEmpty())
+        return;
+
+    const qreal lod = QStyleOptionGraphicsItem::levelOfDetailFromTransform(inPainter->worldTransform());
+    if(lod >= LOD_DETAIL)
+    {
+        m_paintedTier = -1;
+        paintDetail(inPainter, inOption->exposedRect);
+        return;
+    }
+
+    // the smallest cells, which are still big enough on screen
+    int tier = 0;
+    while(tier < NUM_DENSITY_TIERS - 1 and DENSITY_TIERS[tier] * lod < DENSITY_CELL_PIXELS)
+        tier++;
+    m_paintedTier = tier;
+    if(not m_densityCounted[tier])
+    {
+        countDensity(tier);
+        m_densityCounted[tier] = true;
+    }
+    paintDensity(inPainter, inOption->exposedRect, tier);
+}
+
+
+int ShipBatchItem::ownerSlot(const uint inOwner)
+{
+    // there are only a few players
+    for(int slot = 0; slot < m_owners.count(); slot++)
+    {
+        if(m_owners.at(slot).owner == inOwner)
+            return slot;
+    }
+    OwnerShips owner;
+    owner.owner = inOwner;
+    owner.brush = QBrush(PlayerColor::colorForOwner(inOwner));
+    m_owners.append(owner);
+    return m_owners.count() - 1;
+}
+
+
+void ShipBatchItem::countDensity(const int inTier)
+{
+    QVector<DensityCell> & cells = m_density[inTier];
+    cells.resize(0);
+    if(m_centers.isEmpty())
+        return;
+
+    // a grid over all ships, aligned to the cell size
+    const qreal size = DENSITY_TIERS[inTier];
+    const int firstColumn = (int) floor(m_nextBounds.left() / size);
+    const int firstRow = (int) floor(m_nextBounds.top() / size);
+    const int columns = (int) floor(m_nextBounds.right() / size) - firstColumn + 1;
+    const int rows = (int) floor(m_nextBounds.bottom() / size) - firstRow + 1;
+    const int ownerSlots = m_owners.count();
+    m_cellCounts.fill(0, columns * rows * ownerSlots);
+
+    for(int i = 0; i < m_centers.count(); i++)
+    {
+        const QPointF & pos = m_centers.at(i);
+        const int column = qBound(0, (int) floor(pos.x() / size) - firstColumn, columns - 1);
+        const int row = qBound(0, (int) floor(pos.y() / size) - firstRow, rows - 1);
+        m_cellCounts[(row * columns + column) * ownerSlots + m_centerOwners.at(i)]++;
+    }
+
+    for(int cell = 0; cell < columns * rows; cell++)
+    {
+        DensityCell density;
+        density.count = 0;
+        density.ownerSlot = 0;
+        uint best = 0;
+        for(int slot = 0; slot < ownerSlots; slot++)
+        {
+            const uint count = m_cellCounts.at(cell * ownerSlots + slot);
+            density.count += count;
+            if(count > best)
+            {
+                best = count;
+                density.ownerSlot = slot;
+            }
+        }
+        if(density.count == 0)
+            continue;
+        density.rect = QRectF((firstColumn + cell % columns) * size, (firstRow + cell / columns) * size,
+                              size, size);
+        cells.append(density);
+    }
+}
+
+
+void ShipBatchItem::paintDetail(QPainter *inPainter, const QRectF & inExposed)
+{
+    inPainter->setPen(m_pen);
+    const bool all = inExposed.contains(m_bounds);
+    for(const OwnerShips & owner : m_owners)
+    {
+        if(owner.rects.isEmpty())
+            continue;
+        inPainter->setBrush(owner.brush);
+        if(all)
+        {
+            inPainter->drawRects(owner.rects.constData(), owner.rects.count());
+            continue;
+        }
+        // the view asks for the visible and dirty part only, skip all ships outside
+        m_visibleRects.resize(0);
+        for(const QRectF & rect : owner.rects)
+        {
+            if(inExposed.intersects(rect))
+                m_visibleRects.append(rect);
+        }
+        if(! m_visibleRects.isEmpty())
+            inPainter->drawRects(m_visibleRects.constData(), m_visibleRects.count());
+    }
+}
+
+
+void ShipBatchItem::paintDensity(QPainter *inPainter, const QRectF & inExposed, const int inTier)
+{
+    // one glyph per cell, so the cost depends on the screen size, not on the ships
+    inPainter->setPen(Qt::NoPen);
+    for(const DensityCell & cell : m_density[inTier])
+    {
+        if(not inExposed.intersects(cell.rect))
+            continue;
+        // a single ship fills less than half of the cell, 16 and more all of it
+        const qreal fill = qMin(1.0, 0.25 + 0.1875 * sqrt((qreal) cell.count));
+        const qreal inset = cell.rect.width() * (1.0 - fill) / 2.0;
+        inPainter->setBrush(m_owners.at(cell.ownerSlot).brush);
+        inPainter->drawRect(cell.rect.adjusted(inset, inset, -inset, -inset));
+    }
+}
@@ -0,0 +1,132 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+#ifndef SHIPBATCHITEM_H
+#define SHIPBATCHITEM_H
+
+
+#include <QGraphicsItem>
+#include <QBrush>
+#include <QPen>
+#include <QRectF>
+#include <QVector>
+
+
+/**
+ * @brief The ShipBatchItem class draws all sailing ships in one paint()
+ *
+ * UniverseRenderer keeps one item for all ships instead of one item per ship. The item
+ * itself never moves, so the scene index only hears about it, when the area covered
+ * by the ships changes. Ships on isles or in fleets are not drawn at all.
+ *
+ * Zoomed out, where ships would be a few pixels only, paint() draws one glyph per cell
+ * instead: the more ships, the bigger, colored by the owner with the most ships in the
+ * cell. There are some fixed cell sizes (DENSITY_TIERS), paint() picks the smallest one,
+ * which is still DENSITY_CELL_PIXELS wide on screen, and counts its cells once per update.
+ */
+class ShipBatchItem : public QGraphicsItem
+{
+public:
+    explicit ShipBatchItem(QGraphicsItem *inParent = 0);
+
+    // start a new set of positions, keeps the memory of the last one
+    void beginUpdate();
+
+    // ship inShipId centered at inPos. Fastest with growing ids, as in the snapshot
+    void addShip(const uint inShipId, const uint inOwner, const QPointF inPos);
+
+    // done with addShip(). Only the rects of ships, which moved, came or left, get repainted
+    void endUpdate();
+
+    int shipCount() const { return m_ships.count(); }
+
+    QRectF boundingRect() const;
+
+    void paint(QPainter *inPainter, const QStyleOptionGraphicsItem *inOption, QWidget *inWidget);
+
+private:
+    struct ShipRect
+    {
+        uint id;
+        QRectF rect;
+    };
+
+    // ships of one owner, drawn with a single drawRects()
+    struct OwnerShips
+    {
+        uint owner;
+        QBrush brush;
+        QVector<QRectF> rects;
+    };
+
+    // one glyph of the zoomed out view
+    struct DensityCell
+    {
+        QRectF rect;    // the whole cell
+        uint count;
+        int ownerSlot;  // index in m_owners
+    };
+
+    // below this level of detail, ships are drawn as density glyphs
+    static constexpr qreal LOD_DETAIL = 0.3;
+    static const int DENSITY_CELL_PIXELS = 4;
+    static const int NUM_DENSITY_TIERS = 3;
+    static const int DENSITY_TIERS[NUM_DENSITY_TIERS];   // cell sizes in scene units
+
+    int ownerSlot(const uint inOwner);
+
+    void countDensity(const int inTier);
+
+    void paintDetail(QPainter *inPainter, const QRectF & inExposed);
+    void paintDensity(QPainter *inPainter, const QRectF & inExposed, const int inTier);
+
+    QPen m_pen;
+
+    // by owner, in order of appearance. Owners stay, their rects get reused
+    QVector<OwnerShips> m_owners;
+
+    // ships of the last and of the current update, ordered by id, to find what changed.
+    // Both get swapped and reused, so a sync allocates nothing once they are big enough
+    QVector<ShipRect> m_lastShips;
+    QVector<ShipRect> m_ships;
+
+    // position and owner slot of every ship, for countDensity()
+    QVector<QPointF> m_centers;
+    QVector<int> m_centerOwners;
+
+    // false, if addShip() got the ids out of order. Then endUpdate() repaints everything
+    bool m_lastOrdered;
+    bool m_ordered;
+
+    // filled by endUpdate(), kept for the next one
+    QVector<QRectF> m_dirtyRects;
+
+    // non empty cells, one list per tier. Counted on demand, as only one tier gets painted
+    QVector<DensityCell> m_density[NUM_DENSITY_TIERS];
+    bool m_densityCounted[NUM_DENSITY_TIERS];
+    QVector<uint> m_cellCounts;     // cell * owner slot -> ships, scratch for countDensity()
+
+    // tier of the last paint(), -1 for ship rects. Zoomed out, endUpdate() repaints all
+    int m_paintedTier;
+
+    // ships drawn by the last paint(), if only part of the item was exposed
+    QVector<QRectF> m_visibleRects;
+
+    // united rect of all ships, grown by addShip()
+    QRectF m_bounds;
+    QRectF m_nextBounds;
+
+    // m_bounds grown to the cells of the largest tier, as density glyphs fill whole cells.
+    // This is the boundingRect(), so the scene repaints glyphs outside of m_bounds, too
+    QRectF m_densityBounds;
+
+    static QRectF densityBounds(const QRectF & inBounds);
+
+    // above this, endUpdate() repaints the whole item instead of each rect
+    static const int MAX_DIRTY_RECTS = 256;
+};
+
+#endif // SHIPBATCHITEM_H
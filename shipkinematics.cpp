@@ -0,0 +1,166 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+#include <shipkinematics.h>
+#include <ship.h>
+
+#include <math.h>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define WATERWORLD_SSE2
+#endif
+
+
+/* Moves ship i by speed[i] towards target i, unless the ship is near enough
+ * to arrive. Arrived ships keep their position and get appended to outArrived. */
+static void moveShips(const int inCount, float *inOutX, float *inOutY,
+                      const float *inTargetX, const float *inTargetY, const float *inSpeed,
+                      QVector<int> & outArrived)
+{
+    int i = 0;
+#if defined(__AVX__)
+    for(; i + 8 <= inCount; i += 8)
+    {
+        __m256 x = _mm256_loadu_ps(inOutX + i);
+        __m256 y = _mm256_loadu_ps(inOutY + i);
+        __m256 s = _mm256_loadu_ps(inSpeed + i);
+        __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(inTargetX + i), x);
+        __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(inTargetY + i), y);
+        __m256 d2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+        __m256 arrived = _mm256_cmp_ps(d2, _mm256_mul_ps(s, s), _CMP_LE_OQ);
+        // lanes with d == 0 produce garbage here, but they have arrived and get masked
+        __m256 k = _mm256_div_ps(s, _mm256_sqrt_ps(d2));
+        x = _mm256_blendv_ps(_mm256_add_ps(x, _mm256_mul_ps(dx, k)), x, arrived);
+        y = _mm256_blendv_ps(_mm256_add_ps(y, _mm256_mul_ps(dy, k)), y, arrived);
+        _mm256_storeu_ps(inOutX + i, x);
+        _mm256_storeu_ps(inOutY + i, y);
+        int mask = _mm256_movemask_ps(arrived);
+        for(int lane = 0; mask != 0; lane++, mask >>= 1)
+            if(mask & 1)
+                outArrived.append(i + lane);
+    }
+#elif defined(WATERWORLD_SSE2)
+    for(; i + 4 <= inCount; i += 4)
+    {
+        __m128 x = _mm_loadu_ps(inOutX + i);
+        __m128 y = _mm_loadu_ps(inOutY + i);
+        __m128 s = _mm_loadu_ps(inSpeed + i);
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(inTargetX + i), x);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(inTargetY + i), y);
+        __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        __m128 arrived = _mm_cmple_ps(d2, _mm_mul_ps(s, s));
+        // lanes with d == 0 produce garbage here, but they have arrived and get masked
+        __m128 k = _mm_div_ps(s, _mm_sqrt_ps(d2));
+        __m128 movedX = _mm_add_ps(x, _mm_mul_ps(dx, k));
+        __m128 movedY = _mm_add_ps(y, _mm_mul_ps(dy, k));
+        x = _mm_or_ps(_mm_and_ps(arrived, x), _mm_andnot_ps(arrived, movedX));
+        y = _mm_or_ps(_mm_and_ps(arrived, y), _mm_andnot_ps(arrived, movedY));
+        _mm_storeu_ps(inOutX + i, x);
+        _mm_storeu_ps(inOutY + i, y);
+        int mask = _mm_movemask_ps(arrived);
+        for(int lane = 0; mask != 0; lane++, mask >>= 1)
+            if(mask & 1)
+                outArrived.append(i + lane);
+    }
+#endif
+    // scalar fallback and the rest, which does not fill a whole register
+    for(; i < inCount; i++)
+    {
+        float dx = inTargetX[i] - inOutX[i];
+        float dy = inTargetY[i] - inOutY[i];
+        float d2 = dx * dx + dy * dy;
+        if(d2 <= inSpeed[i] * inSpeed[i])
+        {
+            outArrived.append(i);
+            continue;
+        }
+        float k = inSpeed[i] / sqrtf(d2);
+        inOutX[i] = inOutX[i] + dx * k;
+        inOutY[i] = inOutY[i] + dy * k;
+    }
+}
+
+
+void ShipKinematics::set(Ship *inShip, const QPointF inPos, const QPointF inTargetPos, const float inSpeed)
+{
+    int slot = inShip->m_kinematicsSlot;
+    if(slot < 0)
+    {
+        slot = m_ships.count();
+        inShip->m_kinematicsSlot = slot;
+        m_ships.append(inShip);
+        m_x.append(0.0f);
+        m_y.append(0.0f);
+        m_targetX.append(0.0f);
+        m_targetY.append(0.0f);
+        m_speed.append(0.0f);
+    }
+    m_x[slot] = inPos.x();
+    m_y[slot] = inPos.y();
+    m_targetX[slot] = inTargetPos.x();
+    m_targetY[slot] = inTargetPos.y();
+    m_speed[slot] = inSpeed;
+}
+
+
+void ShipKinematics::remove(Ship *inShip)
+{
+    int slot = inShip->m_kinematicsSlot;
+    Q_ASSERT(slot >= 0 and m_ships.at(slot) == inShip);
+    int last = m_ships.count() - 1;
+    if(slot != last)
+    {
+        m_ships[slot] = m_ships.at(last);
+        m_ships[slot]->m_kinematicsSlot = slot;
+        m_x[slot] = m_x.at(last);
+        m_y[slot] = m_y.at(last);
+        m_targetX[slot] = m_targetX.at(last);
+        m_targetY[slot] = m_targetY.at(last);
+        m_speed[slot] = m_speed.at(last);
+    }
+    m_ships.removeLast();
+    m_x.removeLast();
+    m_y.removeLast();
+    m_targetX.removeLast();
+    m_targetY.removeLast();
+    m_speed.removeLast();
+    inShip->m_kinematicsSlot = -1;
+}
+
+
+void ShipKinematics::step(QVector<Ship*> & outArrivals)
+{
+    m_arrivedSlots.clear();
+    moveShips(m_ships.count(), m_x.data(), m_y.data(),
+              m_targetX.constData(), m_targetY.constData(), m_speed.constData(), m_arrivedSlots);
+
+    // write back. Sailing ships stay in their slots, because they still have a target.
+    // Only ships which just left an isle change their position type. That refreshes their
+    // slot from the old position, so it gets the new one again afterwards
+    int arrivedIndex = 0;
+    for(int slot = 0; slot < m_ships.count(); slot++)
+    {
+        Ship *ship = m_ships.at(slot);
+        if(ship->positionType() != ShipPositionEnum::SP_OCEAN)
+        {
+            const float x = m_x.at(slot);
+            const float y = m_y.at(slot);
+            ship->setPositionType(ShipPositionEnum::SP_OCEAN);
+            m_x[slot] = x;
+            m_y[slot] = y;
+        }
+        if(arrivedIndex < m_arrivedSlots.count() and m_arrivedSlots.at(arrivedIndex) == slot)
+        {
+            outArrivals.append(ship);
+            arrivedIndex++;
+        }
+        else
+            ship->sailedTo(QPointF(m_x.at(slot), m_y.at(slot)));
+    }
+}
@@ -0,0 +1,56 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+#ifndef SHIPKINEMATICS_H
+#define SHIPKINEMATICS_H
+
+
+#include <QPointF>
+#include <QVector>
+
+
+class Ship;
+
+
+/**
+ * @brief The ShipKinematics class keeps position, current target and speed of all sailing ships
+ *
+ * A ship sails, if it has a current target and is neither trash nor part of a fleet.
+ * The values are stored in plain float arrays (structure of arrays), so step() can move
+ * all ships in one vectorized pass (AVX or SSE2, depending on the compiler flags, with
+ * a scalar fallback). Ships add, update and remove themselves, see Ship::updateWorldIndex().
+ * Removing a ship moves the last ship into the free slot.
+ */
+class ShipKinematics
+{
+public:
+    int count() const { return m_ships.count(); }
+
+    // insert inShip or update its values
+    void set(Ship *inShip, const QPointF inPos, const QPointF inTargetPos, const float inSpeed);
+
+    void remove(Ship *inShip);
+
+    /**
+     * @brief step - moves every sailing ship one round towards its current target
+     *
+     * Ships, which are already near enough to arrive, don't move. They get appended
+     * to outArrivals instead, in slot order. Every sailing ship is SP_OCEAN afterwards.
+     */
+    void step(QVector<Ship*> & outArrivals);
+
+private:
+    QVector<Ship*> m_ships;
+    QVector<float> m_x;
+    QVector<float> m_y;
+    QVector<float> m_targetX;
+    QVector<float> m_targetY;
+    QVector<float> m_speed;     // ship's technology
+
+    QVector<int> m_arrivedSlots;    // reused by step()
+};
+
+#endif // SHIPKINEMATICS_H
@@ -5,7 +5,7 @@
 
 
 #include <shiplistitem.h>
-#include <player.h>
+#include <playercolor.h>
 
 #include <QPixmap>
 #include <QPainter>
@@ -27,8 +27,8 @@ ShipListItem::ShipListItem(const ShipListItemType inType, const ShipInfo inShipI
             circle.fill(Qt::black);
             QPainter p;
             p.begin(&circle);
-            p.setBrush(QBrush(Player::colorForOwner(inShipInfo.owner)));
-            p.setPen(Player::colorForOwner(inShipInfo.owner));
+            p.setBrush(QBrush(PlayerColor::colorForOwner(inShipInfo.owner)));
+            p.setPen(PlayerColor::colorForOwner(inShipInfo.owner));
             p.drawEllipse(0, 0, 5, 5);
             p.drawEllipse(10, 10, 5, 5);
             p.end();
@@ -36,7 +36,7 @@ ShipListItem::ShipListItem(const ShipListItemType inType, const ShipInfo inShipI
         else if(inShipInfo.posType == ShipPositionEnum::SP_ONISLE)
         {
             // ships sits arround on isle
-            circle.fill(Player::colorForOwner(inShipInfo.owner));
+            circle.fill(PlayerColor::colorForOwner(inShipInfo.owner));
         }
         else if(inShipInfo.posType == ShipPositionEnum::SP_PATROL)
         {
@@ -45,9 +45,9 @@ ShipListItem::ShipListItem(const ShipListItemType inType, const ShipInfo inShipI
             QPainter p;
             p.begin(&circle);
             p.setBrush(QBrush(Qt::black));
-            p.setPen(Player::colorForOwner(inShipInfo.owner));
+            p.setPen(PlayerColor::colorForOwner(inShipInfo.owner));
             p.drawEllipse(0, 0, 15, 15);
-            p.setBrush(Player::colorForOwner(inShipInfo.owner));
+            p.setBrush(PlayerColor::colorForOwner(inShipInfo.owner));
             p.drawEllipse(5, 5, 5, 5);
             p.end();
         }
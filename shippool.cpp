@@ -0,0 +1,60 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+#include <shippool.h>
+
+#include <new>
+#include <QtGlobal>
+
+
+// every block is aligned like memory from operator new
+static const size_t BLOCK_ALIGNMENT = 16;
+
+
+ShipPool::ShipPool(const size_t inBlockSize, const int inBlocksPerSlab)
+    : m_blocksPerSlab(inBlocksPerSlab), m_freeList(0)
+{
+    size_t size = inBlockSize < sizeof(FreeBlock) ? sizeof(FreeBlock) : inBlockSize;
+    m_blockSize = (size + BLOCK_ALIGNMENT - 1) / BLOCK_ALIGNMENT * BLOCK_ALIGNMENT;
+    Q_ASSERT(m_blocksPerSlab > 0);
+}
+
+
+ShipPool::~ShipPool()
+{
+    for(char *slab : m_slabs)
+        ::operator delete(slab);
+}
+
+
+void* ShipPool::allocate()
+{
+    if(m_freeList == 0)
+        addSlab();
+    FreeBlock *block = m_freeList;
+    m_freeList = block->next;
+    return block;
+}
+
+
+void ShipPool::release(void *inBlock)
+{
+    if(inBlock == 0)
+        return;
+    FreeBlock *block = static_cast<FreeBlock*>(inBlock);
+    block->next = m_freeList;
+    m_freeList = block;
+}
+
+
+void ShipPool::addSlab()
+{
+    char *slab = static_cast<char*>(::operator new(m_blockSize * m_blocksPerSlab));
+    m_slabs.append(slab);
+    // link backwards, so the first block of the slab gets used first
+    for(int i = m_blocksPerSlab - 1; i >= 0; i--)
+        release(slab + i * m_blockSize);
+}
@@ -0,0 +1,52 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+#ifndef SHIPPOOL_H
+#define SHIPPOOL_H
+
+
+#include <QVector>
+#include <stddef.h>
+
+
+/**
+ * @brief The ShipPool class hands out memory blocks of one size from big slabs
+ *
+ * Released blocks go to a free list and get reused first, so creating and
+ * destroying ships during heavy fights does not call malloc/free for each ship.
+ * Slabs are never given back before the pool dies. Not thread safe, ships get
+ * created and deleted by the simulation only. See Ship::operator new().
+ */
+class ShipPool
+{
+public:
+    ShipPool(const size_t inBlockSize, const int inBlocksPerSlab);
+    ~ShipPool();
+
+    void* allocate();
+
+    void release(void *inBlock);
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock *next;
+    };
+
+    // add a new slab and put all its blocks into the free list
+    void addSlab();
+
+    size_t m_blockSize;
+    int m_blocksPerSlab;
+    FreeBlock *m_freeList;
+    QVector<char*> m_slabs;
+
+    // no copies
+    ShipPool(const ShipPool &);
+    ShipPool & operator=(const ShipPool &);
+};
+
+#endif // SHIPPOOL_H
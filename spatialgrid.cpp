@@ -0,0 +1,128 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+#include <spatialgrid.h>
+
+#include <math.h>
+
+
+SpatialGrid::SpatialGrid(const qreal inWidth, const qreal inHeight, const qreal inCellSize)
+    : m_cellSize(inCellSize)
+{
+    Q_ASSERT(inCellSize > 0);
+    m_columns = (int) ceil(inWidth / inCellSize);
+    m_rows = (int) ceil(inHeight / inCellSize);
+    if(m_columns < 1)
+        m_columns = 1;
+    if(m_rows < 1)
+        m_rows = 1;
+    m_cells.resize(m_columns * m_rows);
+}
+
+
+void SpatialGrid::insert(const uint inId, const QPointF inPos)
+{
+    Item item;
+    item.id = inId;
+    item.pos = inPos;
+    m_cells[cellIndex(inPos)].append(item);
+}
+
+
+void SpatialGrid::move(const uint inId, const QPointF inOldPos, const QPointF inNewPos)
+{
+    int oldCell = cellIndex(inOldPos);
+    int newCell = cellIndex(inNewPos);
+    if(oldCell != newCell)
+    {
+        remove(inId, inOldPos);
+        insert(inId, inNewPos);
+        return;
+    }
+    // still in the same cell
+    QVector<Item> & cell = m_cells[oldCell];
+    for(Item & item : cell)
+    {
+        if(item.id == inId)
+        {
+            item.pos = inNewPos;
+            return;
+        }
+    }
+    Q_ASSERT(false);    // id was never inserted
+}
+
+
+void SpatialGrid::remove(const uint inId, const QPointF inPos)
+{
+    QVector<Item> & cell = m_cells[cellIndex(inPos)];
+    for(int i = 0; i < cell.count(); i++)
+    {
+        if(cell.at(i).id == inId)
+        {
+            // order within a cell does not matter
+            cell[i] = cell.last();
+            cell.removeLast();
+            return;
+        }
+    }
+    Q_ASSERT(false);    // id was never inserted
+}
+
+
+void SpatialGrid::itemsInRange(const QPointF inPos, const qreal inRange, QVector<Item> & outItems) const
+{
+    int firstColumn = column(inPos.x() - inRange);
+    int lastColumn = column(inPos.x() + inRange);
+    int firstRow = row(inPos.y() - inRange);
+    int lastRow = row(inPos.y() + inRange);
+
+    for(int r = firstRow; r <= lastRow; r++)
+        for(int c = firstColumn; c <= lastColumn; c++)
+            outItems += m_cells.at(r * m_columns + c);
+}
+
+
+void SpatialGrid::itemsInRadius(const QPointF inPos, const qreal inRadius, QVector<Item> & outItems) const
+{
+    const qreal radiusSquare = inRadius * inRadius;
+    int firstColumn = column(inPos.x() - inRadius);
+    int lastColumn = column(inPos.x() + inRadius);
+    int firstRow = row(inPos.y() - inRadius);
+    int lastRow = row(inPos.y() + inRadius);
+
+    for(int r = firstRow; r <= lastRow; r++)
+    {
+        for(int c = firstColumn; c <= lastColumn; c++)
+        {
+            for(const Item & item : m_cells.at(r * m_columns + c))
+            {
+                qreal dx = item.pos.x() - inPos.x();
+                qreal dy = item.pos.y() - inPos.y();
+                if(dx * dx + dy * dy < radiusSquare)
+                    outItems.append(item);
+            }
+        }
+    }
+}
+
+
+int SpatialGrid::column(const qreal inX) const
+{
+    int c = (int) floor(inX / m_cellSize);
+    if(c < 0)
+        return 0;
+    return c < m_columns ? c : m_columns - 1;
+}
+
+
+int SpatialGrid::row(const qreal inY) const
+{
+    int r = (int) floor(inY / m_cellSize);
+    if(r < 0)
+        return 0;
+    return r < m_rows ? r : m_rows - 1;
+}
@@ -0,0 +1,65 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+
+#include <QPointF>
+#include <QVector>
+
+
+/**
+ * @brief The SpatialGrid class is a uniform grid of cells over the universe
+ *
+ * Each water object is stored in the cell which contains its position, so
+ * questions like "what is near this point" only look at a few cells instead of
+ * every object. Positions outside the universe are stored in the border cells.
+ *
+ * Choose the cell size at least as big as the objects, then every object hit by a
+ * point is in the cell of that point or in one of the neighbours.
+ */
+class SpatialGrid
+{
+public:
+    struct Item
+    {
+        uint id;
+        QPointF pos;
+    };
+
+    SpatialGrid(const qreal inWidth, const qreal inHeight, const qreal inCellSize);
+
+    void insert(const uint inId, const QPointF inPos);
+
+    // inOldPos is the pos, the object was inserted with (or moved to)
+    void move(const uint inId, const QPointF inOldPos, const QPointF inNewPos);
+
+    void remove(const uint inId, const QPointF inPos);
+
+    /**
+     * @brief itemsInRange - all items in cells touching the square inPos +/- inRange
+     * @param outItems - candidates, the caller has to do the exact test
+     */
+    void itemsInRange(const QPointF inPos, const qreal inRange, QVector<Item> & outItems) const;
+
+    /**
+     * @brief itemsInRadius - all items with a distance of less than inRadius to inPos
+     */
+    void itemsInRadius(const QPointF inPos, const qreal inRadius, QVector<Item> & outItems) const;
+
+private:
+    int column(const qreal inX) const;
+    int row(const qreal inY) const;
+    int cellIndex(const QPointF inPos) const { return row(inPos.y()) * m_columns + column(inPos.x()); }
+
+    qreal m_cellSize;
+    int m_columns;
+    int m_rows;
+    QVector< QVector<Item> > m_cells;   // row by row
+};
+
+#endif // SPATIALGRID_H
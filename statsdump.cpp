@@ -0,0 +1,72 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+/* waterworld_stats: converts the per round statistics, written by StatsRecorder::save()
+ * (see "WaterWorld --stats"), into CSV with one line per round and player. */
+
+
+#include <statsrecorder.h>
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QStringList>
+#include <stdio.h>
+
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Prints WaterWorld statistics as CSV.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("file", "Statistics written by WaterWorld --stats.");
+    QCommandLineOption ownerOption("owner", "Only rows of player <n>.", "n");
+    parser.addOption(ownerOption);
+    parser.process(app);
+
+    if(parser.positionalArguments().count() != 1)
+        parser.showHelp(1);
+
+    bool ownerOnly = parser.isSet(ownerOption);
+    uint owner = 0;
+    if(ownerOnly)
+    {
+        bool ok = false;
+        owner = parser.value(ownerOption).toUInt(&ok);
+        if(! ok)
+            parser.showHelp(1);
+    }
+
+    StatsRecorder stats;
+    if(! stats.load(parser.positionalArguments().first()))
+    {
+        fprintf(stderr, "cannot read %s\n", qPrintable(parser.positionalArguments().first()));
+        return 1;
+    }
+
+    for(int c = 0; c < StatsRecorder::COL_COUNT; c++)
+        printf(c == 0 ? "%s" : ",%s", StatsRecorder::columnName((StatsRecorder::ColumnEnum) c));
+    printf("\n");
+
+    for(int row = 0; row < stats.rowCount(); row++)
+    {
+        if(ownerOnly and stats.uintValue(StatsRecorder::COL_OWNER, row) != owner)
+            continue;
+        for(int c = 0; c < StatsRecorder::COL_COUNT; c++)
+        {
+            const StatsRecorder::ColumnEnum column = (StatsRecorder::ColumnEnum) c;
+            if(c > 0)
+                printf(",");
+            if(StatsRecorder::isFloatColumn(column))
+                printf("%g", stats.floatValue(column, row));
+            else
+                printf("%u", stats.uintValue(column, row));
+        }
+        printf("\n");
+    }
+    return 0;
+}
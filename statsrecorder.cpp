@@ -0,0 +1,208 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+#include <statsrecorder.h>
+
+#include <QFile>
+#include <QDataStream>
+#include <QByteArray>
+#include <limits>
+
+
+namespace
+{
+    const quint32 STATS_MAGIC = 0x57575354;     // "WWST"
+    const quint32 STATS_VERSION = 1;
+    const quint8 TYPE_UINT = 0;
+    const quint8 TYPE_FLOAT = 1;
+}
+
+
+StatsRecorder::StatsRecorder()
+    : m_numPlayer(0)
+{
+}
+
+
+void StatsRecorder::start(const uint inNumPlayer, const int inExpectedRounds)
+{
+    Q_ASSERT(inNumPlayer > 0);
+    m_numPlayer = inNumPlayer;
+    const int rows = inExpectedRounds * inNumPlayer;
+    for(QVector<quint32> & column : m_uintColumns)
+        column.reserve(rows);
+    for(QVector<float> & column : m_floatColumns)
+        column.reserve(rows);
+    // owner 0 are the unsettled isles, they don't fight
+    m_fightsWon.fill(0, m_numPlayer + 1);
+    m_fightsLost.fill(0, m_numPlayer + 1);
+}
+
+
+void StatsRecorder::countFight(const uint inAttackerOwner, const uint inDefenderOwner,
+                               const EventLog::FightResultEnum inResult)
+{
+    if(! isEnabled())
+        return;
+    switch(inResult)
+    {
+        case EventLog::FR_ATTACKER_WON:
+            countFightResult(m_fightsWon, inAttackerOwner);
+            countFightResult(m_fightsLost, inDefenderOwner);
+            break;
+        case EventLog::FR_DEFENDER_WON:
+            countFightResult(m_fightsLost, inAttackerOwner);
+            countFightResult(m_fightsWon, inDefenderOwner);
+            break;
+        case EventLog::FR_BOTH_DIED:
+            countFightResult(m_fightsLost, inAttackerOwner);
+            countFightResult(m_fightsLost, inDefenderOwner);
+            break;
+    }
+}
+
+
+void StatsRecorder::countFightResult(QVector<quint32> & inOutCounter, const uint inOwner)
+{
+    if((int) inOwner < inOutCounter.count())
+        inOutCounter[inOwner]++;
+}
+
+
+void StatsRecorder::record(const uint inRound, const PlayerStats & inStats)
+{
+    Q_ASSERT(isEnabled());
+    const QVector<OwnerStats> & owners = inStats.owners();
+    for(uint owner = 1; owner <= m_numPlayer; owner++)
+    {
+        const OwnerStats stats = owners.value(owner);
+        m_uintColumns[COL_ROUND].append(inRound);
+        m_uintColumns[COL_OWNER].append(owner);
+        m_uintColumns[COL_ISLES].append(stats.isles);
+        m_uintColumns[COL_BATTLESHIPS].append(stats.ships[ST_BATTLESHIP]);
+        m_uintColumns[COL_COURIERS].append(stats.ships[ST_COURIER]);
+        m_uintColumns[COL_COLONY_SHIPS].append(stats.ships[ST_COLONY]);
+        m_uintColumns[COL_FLEETS].append(stats.ships[ST_FLEET]);
+        m_uintColumns[COL_FIGHTS_WON].append(m_fightsWon.at(owner));
+        m_uintColumns[COL_FIGHTS_LOST].append(m_fightsLost.at(owner));
+        m_floatColumns[COL_POPULATION - COL_POPULATION].append(stats.population);
+        m_floatColumns[COL_TECHNOLOGY - COL_POPULATION].append(stats.isles > 0 ? stats.technology / stats.isles : 0.0);
+    }
+    m_fightsWon.fill(0);
+    m_fightsLost.fill(0);
+}
+
+
+quint32 StatsRecorder::uintValue(const ColumnEnum inColumn, const int inRow) const
+{
+    Q_ASSERT(not isFloatColumn(inColumn));
+    return m_uintColumns[inColumn].at(inRow);
+}
+
+
+float StatsRecorder::floatValue(const ColumnEnum inColumn, const int inRow) const
+{
+    Q_ASSERT(isFloatColumn(inColumn));
+    return m_floatColumns[inColumn - COL_POPULATION].at(inRow);
+}
+
+
+bool StatsRecorder::save(const QString & inFileName) const
+{
+    QFile file(inFileName);
+    if(! file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+    QDataStream out(&file);
+    out.setByteOrder(QDataStream::LittleEndian);
+    out.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    out << STATS_MAGIC << STATS_VERSION << (quint32) COL_COUNT << (quint32) rowCount();
+    for(int c = 0; c < COL_COUNT; c++)
+    {
+        const ColumnEnum column = (ColumnEnum) c;
+        out << QByteArray(columnName(column));
+        if(isFloatColumn(column))
+        {
+            out << TYPE_FLOAT;
+            for(float value : m_floatColumns[c - COL_POPULATION])
+                out << value;
+        }
+        else
+        {
+            out << TYPE_UINT;
+            for(quint32 value : m_uintColumns[c])
+                out << value;
+        }
+    }
+    return out.status() == QDataStream::Ok;
+}
+
+
+bool StatsRecorder::load(const QString & inFileName)
+{
+    QFile file(inFileName);
+    if(! file.open(QIODevice::ReadOnly))
+        return false;
+    QDataStream in(&file);
+    in.setByteOrder(QDataStream::LittleEndian);
+    in.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    quint32 magic, version, columns, rows;
+    in >> magic >> version >> columns >> rows;
+    if(in.status() != QDataStream::Ok or magic != STATS_MAGIC or version != STATS_VERSION or
+            columns != COL_COUNT)
+        return false;
+    // each value takes 4 bytes, so a valid file holds at least rows * COL_COUNT * 4 bytes
+    if(rows > (quint32) std::numeric_limits<int>::max() or
+            (qint64) rows * COL_COUNT * 4 > file.size())
+        return false;
+
+    for(int c = 0; c < COL_COUNT; c++)
+    {
+        const ColumnEnum column = (ColumnEnum) c;
+        QByteArray name;
+        quint8 type;
+        in >> name >> type;
+        if(in.status() != QDataStream::Ok or name != columnName(column) or
+                type != (isFloatColumn(column) ? TYPE_FLOAT : TYPE_UINT))
+            return false;
+        if(isFloatColumn(column))
+        {
+            QVector<float> & values = m_floatColumns[c - COL_POPULATION];
+            values.resize(rows);
+            for(float & value : values)
+                in >> value;
+        }
+        else
+        {
+            QVector<quint32> & values = m_uintColumns[c];
+            values.resize(rows);
+            for(quint32 & value : values)
+                in >> value;
+        }
+        if(in.status() != QDataStream::Ok)
+            return false;
+    }
+    return true;
+}
+
+
+const char* StatsRecorder::columnName(const ColumnEnum inColumn)
+{
+    switch(inColumn)
+    {
+        case COL_ROUND: return "round";
+        case COL_OWNER: return "owner";
+        case COL_ISLES: return "isles";
+        case COL_BATTLESHIPS: return "battleships";
+        case COL_COURIERS: return "couriers";
+        case COL_COLONY_SHIPS: return "colony_ships";
+        case COL_FLEETS: return "fleets";
+        case COL_FIGHTS_WON: return "fights_won";
+        case COL_FIGHTS_LOST: return "fights_lost";
+        case COL_POPULATION: return "population";
+        case COL_TECHNOLOGY: return "technology";
+        default: return "unknown";
+    }
+}
@@ -0,0 +1,81 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+#ifndef STATSRECORDER_H
+#define STATSRECORDER_H
+
+
+#include <playerstats.h>
+#include <eventlog.h>
+#include <QtGlobal>
+#include <QVector>
+#include <QString>
+
+
+/**
+ * @brief The StatsRecorder class keeps a time series of the per player statistics
+ *
+ * After every round, record() appends one row per player: isles, population, mean
+ * technology of the isles, ships by type and the fights won and lost in that round.
+ * The rows are kept column by column in buffers, which start() allocates for the
+ * expected number of rounds, so recording a round is a few appends.
+ *
+ * save() writes the columns into a binary file, see statsdump.cpp for the CSV converter.
+ * Recording is off until start() gets called.
+ */
+class StatsRecorder
+{
+public:
+    // all columns in file order. The ones before COL_POPULATION are quint32, the others float
+    enum ColumnEnum { COL_ROUND = 0, COL_OWNER, COL_ISLES,
+                      COL_BATTLESHIPS, COL_COURIERS, COL_COLONY_SHIPS, COL_FLEETS,
+                      COL_FIGHTS_WON, COL_FIGHTS_LOST,
+                      COL_POPULATION, COL_TECHNOLOGY,
+                      COL_COUNT };
+
+    static const int NUM_UINT_COLUMNS = COL_POPULATION;
+    static const int NUM_FLOAT_COLUMNS = COL_COUNT - COL_POPULATION;
+
+    StatsRecorder();
+
+    // record owners 1..inNumPlayer from now on, buffers hold inExpectedRounds without growing
+    void start(const uint inNumPlayer, const int inExpectedRounds = 1000);
+    bool isEnabled() const { return m_numPlayer > 0; }
+
+    // a fight finished, counted for the round being recorded next
+    void countFight(const uint inAttackerOwner, const uint inDefenderOwner,
+                    const EventLog::FightResultEnum inResult);
+
+    // one row per player with the stats after inRound
+    void record(const uint inRound, const PlayerStats & inStats);
+
+    int rowCount() const { return m_uintColumns[COL_ROUND].count(); }
+
+    quint32 uintValue(const ColumnEnum inColumn, const int inRow) const;
+    float floatValue(const ColumnEnum inColumn, const int inRow) const;
+
+    // binary file: magic, version, number of columns and rows, then each column:
+    // name, type (0: quint32, 1: float) and all of its values
+    bool save(const QString & inFileName) const;
+    bool load(const QString & inFileName);
+
+    static bool isFloatColumn(const ColumnEnum inColumn) { return inColumn >= COL_POPULATION; }
+    static const char* columnName(const ColumnEnum inColumn);
+
+private:
+    uint m_numPlayer;   // 0: not recording
+
+    QVector<quint32> m_uintColumns[NUM_UINT_COLUMNS];
+    QVector<float> m_floatColumns[NUM_FLOAT_COLUMNS];
+
+    // fights of the current round, by owner
+    QVector<quint32> m_fightsWon;
+    QVector<quint32> m_fightsLost;
+
+    void countFightResult(QVector<quint32> & inOutCounter, const uint inOwner);
+};
+
+#endif // STATSRECORDER_H
@@ -0,0 +1,121 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+#include <tracerecorder.h>
+
+#include <QCoreApplication>
+#include <QMutexLocker>
+#include <QThread>
+
+
+TraceRecorder & TraceRecorder::instance()
+{
+    static TraceRecorder recorder;
+    return recorder;
+}
+
+
+TraceRecorder::TraceRecorder()
+    : m_enabled(0), m_pid(0), m_firstEvent(true)
+{
+}
+
+
+bool TraceRecorder::start(const QString & inFileName)
+{
+    QMutexLocker locker(&m_mutex);
+    if(isEnabled())
+        return false;
+    m_file.setFileName(inFileName);
+    if(! m_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+    m_file.write("[\n");
+    m_firstEvent = true;
+    m_tids.clear();
+    m_pid = QCoreApplication::applicationPid();
+    m_clock.start();
+    m_enabled.store(1);
+    return true;
+}
+
+
+void TraceRecorder::stop()
+{
+    QMutexLocker locker(&m_mutex);
+    if(! isEnabled())
+        return;
+    m_enabled.store(0);
+    m_file.write("\n]\n");
+    m_file.close();
+}
+
+
+void TraceRecorder::addSpan(const char *inName, const qint64 inStartUs, const qint64 inDurationUs,
+                            const char *inArgName, const qint64 inArgValue)
+{
+    QMutexLocker locker(&m_mutex);
+    // stop() may have come in between
+    if(! isEnabled())
+        return;
+
+    QByteArray json = "{\"name\":\"";
+    json += inName;
+    json += "\",\"cat\":\"waterworld\",\"ph\":\"X\",\"ts\":";
+    json += QByteArray::number(inStartUs);
+    json += ",\"dur\":";
+    json += QByteArray::number(inDurationUs);
+    json += ",\"pid\":";
+    json += QByteArray::number(m_pid);
+    json += ",\"tid\":";
+    json += QByteArray::number(currentThreadTid());
+    if(inArgName)
+    {
+        json += ",\"args\":{\"";
+        json += inArgName;
+        json += "\":";
+        json += QByteArray::number(inArgValue);
+        json += "}";
+    }
+    json += "}";
+    writeEvent(json);
+}
+
+
+int TraceRecorder::currentThreadTid()
+{
+    Qt::HANDLE handle = QThread::currentThreadId();
+    QHash<Qt::HANDLE, int>::const_iterator it = m_tids.constFind(handle);
+    if(it != m_tids.constEnd())
+        return it.value();
+
+    const int tid = m_tids.count() + 1;
+    m_tids.insert(handle, tid);
+
+    // name the row in the viewer
+    QString threadName = QThread::currentThread()->objectName();
+    if(threadName.isEmpty())
+        threadName = QCoreApplication::instance() and
+                QThread::currentThread() == QCoreApplication::instance()->thread() ?
+                    QString("main") : QString("thread %1").arg(tid);
+    QByteArray json = "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":";
+    json += QByteArray::number(m_pid);
+    json += ",\"tid\":";
+    json += QByteArray::number(tid);
+    json += ",\"args\":{\"name\":\"";
+    json += threadName.toUtf8();
+    json += "\"}}";
+    writeEvent(json);
+    return tid;
+}
+
+
+void TraceRecorder::writeEvent(const QByteArray & inJson)
+{
+    if(! m_firstEvent)
+        m_file.write(",\n");
+    m_firstEvent = false;
+    m_file.write(inJson);
+}
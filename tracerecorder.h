@@ -0,0 +1,104 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+#ifndef TRACERECORDER_H
+#define TRACERECORDER_H
+
+
+#include <QtGlobal>
+#include <QString>
+#include <QFile>
+#include <QHash>
+#include <QMutex>
+#include <QAtomicInt>
+#include <QElapsedTimer>
+
+
+/**
+ * @brief The TraceRecorder class streams spans into a Chrome trace-event JSON file
+ *
+ * Load the file into chrome://tracing or https://ui.perfetto.dev. There is one recorder
+ * per process, see instance(). Spans come from every thread (the GUI, the computer
+ * players on the thread pool), each thread gets its own row. Until start() is called,
+ * a span costs one atomic read.
+ */
+class TraceRecorder
+{
+public:
+    static TraceRecorder & instance();
+
+    // open inFileName and record from now on, false if the file can't be written
+    bool start(const QString & inFileName);
+
+    // write the end of the JSON file and stop recording
+    void stop();
+
+    bool isEnabled() const { return m_enabled.load() != 0; }
+
+    // microseconds since start()
+    qint64 nowUs() const { return m_clock.nsecsElapsed() / 1000; }
+
+    // a complete span, inArgName may be 0 for no argument
+    void addSpan(const char *inName, const qint64 inStartUs, const qint64 inDurationUs,
+                 const char *inArgName, const qint64 inArgValue);
+
+private:
+    TraceRecorder();
+    Q_DISABLE_COPY(TraceRecorder)
+
+    // small, stable id of the calling thread. Announces new threads. Call with m_mutex locked
+    int currentThreadTid();
+
+    void writeEvent(const QByteArray & inJson);
+
+    QAtomicInt m_enabled;
+    QMutex m_mutex;
+    QFile m_file;
+    QElapsedTimer m_clock;
+    qint64 m_pid;
+    bool m_firstEvent;
+    QHash<Qt::HANDLE, int> m_tids;
+};
+
+
+/**
+ * @brief The TraceSpan class records the time between construction and destruction as a span
+ */
+class TraceSpan
+{
+public:
+    explicit TraceSpan(const char *inName, const char *inArgName = 0, const qint64 inArgValue = 0)
+        : m_name(inName), m_argName(inArgName), m_argValue(inArgValue),
+          m_startUs(TraceRecorder::instance().isEnabled() ? TraceRecorder::instance().nowUs() : -1) {}
+
+    ~TraceSpan()
+    {
+        if(m_startUs >= 0 and TraceRecorder::instance().isEnabled())
+        {
+            TraceRecorder & recorder = TraceRecorder::instance();
+            recorder.addSpan(m_name, m_startUs, recorder.nowUs() - m_startUs, m_argName, m_argValue);
+        }
+    }
+
+private:
+    Q_DISABLE_COPY(TraceSpan)
+    const char *m_name;
+    const char *m_argName;
+    const qint64 m_argValue;
+    const qint64 m_startUs;     // -1, if the recorder was off
+};
+
+
+#ifndef WATERWORLD_NO_TRACE
+// trace the rest of the enclosing scope, one per scope. name must be a string literal
+#define WW_TRACE_SPAN(name) TraceSpan wwTraceSpan(name)
+#define WW_TRACE_SPAN_ARG(name, argName, argValue) TraceSpan wwTraceSpan((name), (argName), (argValue))
+#else
+#define WW_TRACE_SPAN(name) do {} while(0)
+#define WW_TRACE_SPAN_ARG(name, argName, argValue) do {} while(0)
+#endif
+
+#endif // TRACERECORDER_H
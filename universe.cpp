@@ -6,24 +6,45 @@
 
 #include <universe.h>
 #include <player.h>
+#include <tracerecorder.h>
 
-#include <stdlib.h>     /* srand, rand */
-#include <time.h>
-#include <QBrush>
+#include <algorithm>
 #include <QDebug>
+#include <QRunnable>
+#include <QMutexLocker>
+#include <QMetaMethod>
 
 
-Universe::Universe(QObject *inParent, UniverseScene *& inOutUniverseScene, const qreal inUniverseWidth,
-                   const qreal inUniverseHeight, const uint inNumIsles, const uint numEnemies)
-    : QObject(inParent), m_lastInsertedId(10)
+/* Runs ComputerPlayer::nextRound() inside the strategy pool. The player only
+ * reads its own snapshot from prepareStrategies() and writes its own moves,
+ * so players don't need any locking. */
+class StrategyTask : public QRunnable
 {
-    createIsles(inUniverseWidth, inUniverseHeight, inNumIsles);
+public:
+    StrategyTask(ComputerPlayer *inPlayer, QList<ComputerMove> *outMoves)
+        : m_player(inPlayer), m_moves(outMoves) {}
+
+    void run() { m_player->nextRound(*m_moves); }
+
+private:
+    ComputerPlayer *m_player;
+    QList<ComputerMove> *m_moves;
+};
 
-    // add created isles to the scene
-    for(Isle *isle : m_isles)
-    {
-        inOutUniverseScene->addItem(isle->shape());
-    }
+
+Universe::Universe(QObject *inParent, const qreal inUniverseWidth,
+                   const qreal inUniverseHeight, const uint inNumIsles, const uint numEnemies,
+                   const quint64 inSeed)
+    : QObject(inParent), m_round(0), m_lastInsertedId(10),
+      m_worldIndex(inUniverseWidth, inUniverseHeight),
+      m_isleGrid(inUniverseWidth, inUniverseHeight, 2.0f * Isle::RADIUS),
+      m_random(inSeed), m_printProfile(false), m_snapshotRecycler(new SnapshotRecycler)
+{
+    qInfo() << "Universe seed: " << inSeed;
+
+    // ships find their isle garrison through the world index
+    m_worldIndex.setIsles(&m_isles, &m_isleIndex);
+    createIsles(inUniverseWidth, inUniverseHeight, inNumIsles);
 
     for(uint i = 0; i < numEnemies; i++)
     {
@@ -31,7 +52,7 @@ Universe::Universe(QObject *inParent, UniverseScene *& inOutUniverseScene, const
     }
 
     Isle *isle = m_isles.at(0);
-    isle->setOwner(Player::PLAYER_HUMAN, Player::colorForOwner(Player::PLAYER_HUMAN));
+    isle->setOwner(Player::PLAYER_HUMAN);
 
     for(int i = 0; i < m_computerPlayers.count(); i++)
     {
@@ -39,7 +60,7 @@ Universe::Universe(QObject *inParent, UniverseScene *& inOutUniverseScene, const
 
         uint idx = i + 1;   // prevent warning: comparison signed/unsigned
         ComputerPlayer *cPlayer = m_computerPlayers.at(i);
-        if( idx > inNumIsles )
+        if( idx >= inNumIsles )     // isle 0 belongs to the human
         {
             // too many player: marke as "dead".
             cPlayer->setDead();
@@ -47,54 +68,11 @@ Universe::Universe(QObject *inParent, UniverseScene *& inOutUniverseScene, const
         }
         uint owner = cPlayer->owner();
         isle = m_isles.at(1 + i);
-        isle->setOwner(owner, Player::colorForOwner(owner));
+        isle->setOwner(owner);
     }
-}
-
 
-void Universe::deleteShipOnIsle(const uint inShipId)
-{
-    uint isleId = 0;
-    for(Ship *s : m_ships)
-    {
-        ShipInfo sInfo = s->info();
-        if(sInfo.id == inShipId)
-        {
-            isleId = sInfo.isleId;
-            // just to get sure
-            if((sInfo.posType != ShipPositionEnum::SP_OCEAN) and isleId > 0)
-            {
-                deleteShip(inShipId);
-                IsleInfo iInfo;
-                isleForId(isleId, iInfo);
-                showHumanIsle(iInfo);
-            }
-            break;
-        }
-    }
-}
-
-
-void Universe::setShipPatrolsIsle(const uint inShipId)
-{
-    int shipIndex = shipIndexForId(inShipId);
-    if(shipIndex >= 0)
-    {
-        Ship *s = m_ships[shipIndex];
-        ShipInfo sInfo = s->info();
-        if(sInfo.posType == ShipPositionEnum::SP_OCEAN or sInfo.posType == ShipPositionEnum::SP_IN_FLEET)
-            return;
-        s->removeTargets();
-        // toggle Patruille status:
-        if(sInfo.posType == ShipPositionEnum::SP_ONISLE)
-            s->setPositionType(ShipPositionEnum::SP_PATROL);
-        else
-            s->setPositionType(ShipPositionEnum::SP_ONISLE);
-        // redraw isle info
-        IsleInfo iInfo;
-        isleForId(sInfo.isleId, iInfo);
-        showHumanIsle(iInfo);
-    }
+    // observers may read snapshot() right after construction
+    publishChanges();
 }
 
 
@@ -140,338 +118,437 @@ void Universe::isleForId(const uint inIsleId, IsleInfo & outIsleInfo)
 {
     outIsleInfo.id = 0;
     int isleIndex = isleIndexForId(inIsleId);
-    if(isleIndex >= -1)
+    if(isleIndex >= 0)
         outIsleInfo = m_isles.at(isleIndex)->info();
 }
 
 
-void Universe::isleSetShipToBuild(const uint inIsleId, const ShipTypeEnum inShipToBuild)
+void Universe::shipAddToFleet(const uint inIsleId, const uint inFleetId, const uint inShipId)
 {
-    int isleIndex = isleIndexForId(inIsleId);
-    if(isleIndex < 0)
-        return;
-    m_isles[isleIndex]->setShipToBuild(inShipToBuild);
+    // cannot assign a ship to itself
+    Q_ASSERT(inFleetId != inShipId);
+    // inShipId cannot be 0
+    Q_ASSERT(inShipId != 0);
+    // inIsleId cannot be 0
+    Q_ASSERT(inIsleId != 0);
+
+
+    Ship *fleetShip;
+    Ship *shipToAdd;
+
+    IsleInfo isleInfo;
+    isleForId(inIsleId, isleInfo);
+
+    int shipIndex = shipIndexForId(inShipId);
+    Q_ASSERT(shipIndex >= 0);   // ship must exist
+    shipToAdd = m_ships[shipIndex];
+    ShipInfo shipToAddInfo;
+    shipToAddInfo = shipToAdd->info();
+
+    if(inFleetId == 0)
+    {   // create a new fleet, which is just a ship representing all other ships
+        fleetShip = new Ship(&m_worldIndex, ShipTypeEnum::ST_FLEET, m_lastInsertedId++, shipToAddInfo.owner,
+                           isleInfo.pos, ShipPositionEnum::SP_ONISLE,
+                           isleInfo.id, shipToAddInfo.technology);
+        m_ships.push_back(fleetShip);
+        m_shipIndex.insert(fleetShip->id(), m_ships.count() - 1);
+    }
+    else
+    {
+        int fleetIndex = shipIndexForId(inFleetId);
+        Q_ASSERT(fleetIndex >= 0);
+        fleetShip = m_ships[fleetIndex];
+    }
+
+    // the ship vanishes from the map, so whoever pursued it loses this target
+    QVector<Ship*> pursuers = m_worldIndex.pursuers.pursuers(inShipId);
+    for(Ship *s : pursuers)
+        s->removeTargetShip(inShipId);
+
+    shipToAdd->addToFleet(fleetShip->id());
+    fleetShip->addShipToFleet(shipToAdd);
+
+    // the fleet owns the ship now. Leave a tombstone, the caller runs compactShips()
+    m_ships[shipIndex] = 0;
+    m_shipIndex.remove(inShipId);
+    // for the computer players, the ship left the map like a destroyed one
+    m_worldIndex.changes.shipDestroyed(inShipId);
 }
 
 
-void Universe::getAllIsleInfos(QList<IsleInfo> & outIsleInfos)
+void Universe::nextRound()
 {
-    outIsleInfos.clear();
-    for(Isle *isle : m_isles)
-        outIsleInfos.append(isle->info());
+    simulateRound();
+    publishChanges();
+    emit sigRoundFinished();
 }
 
 
-void Universe::getAllShipInfos(QList<ShipInfo> & outShipInfo)
+void Universe::nextRounds(const uint inRounds)
 {
-    outShipInfo.clear();
-    for(Ship *ship : m_ships)
-        outShipInfo.append(ship->info());
+    WW_TRACE_SPAN_ARG("Universe::nextRounds", "rounds", inRounds);
+    for(uint i = 0; i < inRounds; i++)
+        simulateRound();
+    publishChanges();
+    emit sigRoundFinished();
 }
 
 
-void Universe::removeDefaultIsleTarget(const uint inIsleId)
+bool Universe::postHumanMove(const ComputerMove & inMove)
 {
-    int isleIndex = isleIndexForId(inIsleId);
-    if(isleIndex >= 0)
-        m_isles[isleIndex]->setDefaultTargetNothing();
+    if(! m_humanMoves.push(inMove))
+        return false;
+    // the moves get applied between the rounds, or at the start of the running one
+    QMetaObject::invokeMethod(this, "processHumanMoves", Qt::QueuedConnection);
+    return true;
 }
 
 
-void Universe::removeAllShipTargets(const uint inShipId)
+void Universe::processHumanMoves()
 {
-    int index = shipIndexForId(inShipId);
-    if(index < 0)
-        return;
-    m_ships[index]->removeTargets();
+    if(applyHumanMoves())
+        publishChanges();
 }
 
 
-void Universe::removeShipTargetByIndex(const uint inShipId, const int inIndex)
+bool Universe::applyHumanMoves()
 {
-    int index = shipIndexForId(inShipId);
-    if(index < 0)
-        return;
-    m_ships[index]->removeTargetByIndex(inIndex);
+    QList<ComputerMove> moves;
+    if(m_humanMoves.take(moves) == 0)
+        return false;
+    processStrategyCommands(Player::PLAYER_HUMAN, moves);
+    return true;
 }
 
 
-void Universe::shipSetCycleTargets(const uint inShipId, const uint inCycle)
+QSharedPointer<const UniverseSnapshot> Universe::snapshot() const
 {
-    int index = shipIndexForId(inShipId);
-    if(index < 0)
-        return;
-    m_ships[index]->setCycleTargets(inCycle);
+    QMutexLocker locker(&m_snapshotMutex);
+    return m_snapshot;
 }
 
 
-void Universe::shipAddToFleet(UniverseScene *& inOutUniverseScene, const uint inIsleId, const uint inFleetId, const uint inShipId)
+void Universe::registerMetaTypes()
 {
-    // cannot assign a ship to itself
-    Q_ASSERT(inFleetId != inShipId);
-    // inShipId cannot be 0
-    Q_ASSERT(inShipId != 0);
-    // inIsleId cannot be 0
-    Q_ASSERT(inIsleId != 0);
+    qRegisterMetaType<IsleInfo>("IsleInfo");
+    qRegisterMetaType<ShipInfo>("ShipInfo");
+    qRegisterMetaType<Target>("Target");
+    qRegisterMetaType<ShipTypeEnum>("ShipTypeEnum");
+    qRegisterMetaType<InfoscreenPageEnum>("InfoscreenPageEnum");
+    qRegisterMetaType< QList<ShipInfo> >("QList<ShipInfo>");
+    qRegisterMetaType< QVector<Target> >("QVector<Target>");
+}
 
 
-    Ship *fleetShip;
-    Ship *shipToAdd;
+void Universe::publishChanges()
+{
+    // only the simulation thread writes m_snapshot, so it may read it without locking
+    static const QMetaMethod changedSignal = QMetaMethod::fromSignal(&Universe::sigUniverseChanged);
+    if(not m_snapshot.isNull() and not isSignalConnected(changedSignal))
+        return;
 
-    IsleInfo isleInfo;
-    isleForId(inIsleId, isleInfo);
+    WW_TRACE_SPAN("Universe::publishChanges");
+    UniverseSnapshot *back = m_snapshotRecycler->take();
+    back->round = m_round;
+    // assign instead of append, so a recycled snapshot keeps its buffers
+    back->isles.resize(m_isles.count());
+    for(int i = 0; i < m_isles.count(); i++)
+        back->isles[i] = m_isles.at(i)->info();
+    back->ships.resize(m_ships.count());
+    back->humanShipTargets.clear();
+    for(int i = 0; i < m_ships.count(); i++)
+    {
+        const Ship *ship = m_ships.at(i);
+        back->ships[i] = ship->info();
+        if(ship->owner() == Player::PLAYER_HUMAN)
+            back->humanShipTargets.insert(ship->id(), ship->targets());
+    }
+    back->buildIndex();
+    // isles and ships keep the stats up to date, so this is just a copy
+    back->playerStats = m_worldIndex.stats;
 
-    int shipIndex = shipIndexForId(inShipId);
-    Q_ASSERT(shipIndex >= 0);   // ship must exist
-    shipToAdd = m_ships[shipIndex];
-    ShipInfo shipToAddInfo;
-    shipToAddInfo = shipToAdd->info();
-    Q_ASSERT(shipToAddInfo.owner == isleInfo.owner);    // don't add enemy ships to fleet
+    // readers keep the old snapshot alive, as long as they hold it
+    QSharedPointer<const UniverseSnapshot> front = SnapshotRecycler::share(back, m_snapshotRecycler);
+    {
+        QMutexLocker locker(&m_snapshotMutex);
+        m_snapshot.swap(front);
+    }
+    emit sigUniverseChanged();
+}
 
-    if(inFleetId == 0)
-    {   // create a new fleet, which is just a ship representing all other ships
-        fleetShip = new Ship(inOutUniverseScene, ShipTypeEnum::ST_FLEET, m_lastInsertedId++, isleInfo.owner,
-                           isleInfo.pos, isleInfo.color, ShipPositionEnum::SP_ONISLE,
-                           isleInfo.id, isleInfo.technology);
-        m_ships.push_back(fleetShip);
 
+void Universe::simulateRound()
+{
+    WW_TRACE_SPAN("Universe::nextRound");
+    m_round++;
+    m_eventLog.setRound(m_round);
+    m_roundProfile.clear();
+
+    // orders of the human, which came in while the last round was running
+    applyHumanMoves();
+
+    {
+        WW_PROFILE_PHASE(m_roundProfile, PH_PREPARE_STRATEGIES);
+        WW_TRACE_SPAN("prepare_strategies");
+        prepareStrategies();
     }
-    else
     {
-        int fleetIndex = shipIndexForId(inFleetId);
-        Q_ASSERT(fleetIndex >= 0);
-        fleetShip = m_ships[fleetIndex];
+        WW_PROFILE_PHASE(m_roundProfile, PH_STRATEGIES);
+        WW_TRACE_SPAN("strategies");
+        strategiesNextRound();
+    }
+    {
+        WW_PROFILE_PHASE(m_roundProfile, PH_ISLES);
+        WW_TRACE_SPAN("isles");
+        islesNextRound();
     }
+    {
+        WW_PROFILE_PHASE(m_roundProfile, PH_SHIPS);
+        WW_TRACE_SPAN("ships");
+        shipsNextRound();
+    }
+    {
+        WW_PROFILE_PHASE(m_roundProfile, PH_CLEANUP);
+        WW_TRACE_SPAN("cleanup");
+        cleanupNextRound();
+    }
+    if(m_statsRecorder.isEnabled())
+        m_statsRecorder.record(m_round, m_worldIndex.stats);
 
+    m_lastRoundProfile = m_roundProfile;
+    if(m_printProfile)
+        WW_PROFILE_PRINT(m_lastRoundProfile);
+}
 
 
-    qInfo() << "Universe::shipAddToFleet() -> implementation ?? ";
+void Universe::strategiesNextRound()
+{
+    // every player gets its own list of moves, applied in order of m_computerPlayers
+    // after all players are done. So the result does not depend on thread timing.
+    QVector< QList<ComputerMove> > computerMoves(m_computerPlayers.count());
+    for(int i = 0; i < m_computerPlayers.count(); i++)
+    {
+        if(! m_computerPlayers.at(i)->isDead())
+            m_strategyPool.start(new StrategyTask(m_computerPlayers.at(i), &computerMoves[i]));
+    }
+    m_strategyPool.waitForDone();
+    for(int i = 0; i < m_computerPlayers.count(); i++)
+    {
+        if(! m_computerPlayers.at(i)->isDead())
+            processStrategyCommands(m_computerPlayers.at(i)->owner(), computerMoves.at(i));
+    }
 }
 
 
-void Universe::nextRound(UniverseScene *& inOutUniverseScene)
+void Universe::islesNextRound()
 {
-    qInfo() << "BEGIN NEXTROUND ==================";
-    prepareStrategies();
-    for(ComputerPlayer *player : m_computerPlayers)
+    for(Isle *isle : m_isles)
     {
-        if(player->isDead())
-            continue;
-        QList<ComputerMove> computerMoves;
-        player->nextRound(computerMoves);
-        processStrategyCommands(player->owner(), computerMoves);
+        if(isle->nextRound())
+        {
+            createShipOnIsle(isle->info());
+        }
     }
+}
+
+
+void Universe::shipsNextRound()
+{
+    // move all sailing ships at once
+    QVector<Ship*> arrivals;
+    m_worldIndex.kinematics.step(arrivals);
+    WW_PROFILE_COUNT(m_roundProfile, CT_ARRIVALS, arrivals.count());
 
+    // repair ships on isle. Ships with a target have just left, ships arriving now wait for the next round.
+    // A fleet may turn into trash while repairing and leave the list, so step ahead first
     for(Isle *isle : m_isles)
     {
-        if(isle->nextRound())
+        Ship *next = isle->shipsOnIsle().first();
+        while(next)
         {
-            createShipOnIsle(inOutUniverseScene, isle->info());
+            Ship *ship = next;
+            next = ship->nextInGarrison();
+            if(! ship->isDead())
+                ship->repair();
         }
     }
 
-    for(Ship *ship : m_ships)
+    // handle arrivals in order of creation, which is the order of m_ships, as ids grow
+    std::sort(arrivals.begin(), arrivals.end(),
+              [](Ship *a, Ship *b) { return a->id() < b->id(); });
+    for(Ship *ship : arrivals)
     {
         ShipInfo shipInfo = ship->info();
 
-        if(ship->isDead())
+        // a fight with an other arriving ship may have killed us or taken our target
+        if(ship->isDead() or not shipInfo.hasTarget)
             continue;
 
-        if( ship->nextRound() ) // ship->nextRound() returns true on arrive
-        {   // arrived
+        // as ships which arrived in heaven get cought above, the ships here MUST
+        // have a target, so it is save to call:
+        Target target = ship->currentTarget();
 
-            // as ships which arrived in heaven get cought above, the ships here MUST
-            // have a target, so it is save to call:
-            Target target = ship->currentTarget();
-
-            if(target.tType == Target::TargetEnum::T_ISLE)
-            {
-                // land or fight
-                IsleInfo isleInfo;
-                isleForId(target.id, isleInfo);
+        if(target.tType == Target::TargetEnum::T_ISLE)
+        {
+            // land or fight
+            IsleInfo isleInfo;
+            isleForId(target.id, isleInfo);
 
-                if(isleInfo.owner == Player::PLAYER_UNSETTLED)
-                {   // isle has no inhabitants
+            if(isleInfo.owner == Player::PLAYER_UNSETTLED)
+            {   // isle has no inhabitants
 
-                    shipFightIslePatol(ship, target.id);
-                    if(ship->isDead())
-                        continue;   // ship is destroyed
+                shipFightIslePatol(ship, target.id);
+                if(ship->isDead())
+                    continue;   // ship is destroyed
 
-                    if(shipInfo.shipType == ShipTypeEnum::ST_COLONY)
+                if(shipInfo.shipType == ShipTypeEnum::ST_COLONY)
+                {
+                    setIsleOwnerById(isleInfo.id, shipInfo.owner);
+                    shipLandOnIsle(ship, isleInfo.id);
+                    // colony ships get destroyed as they land, because
+                    // the ship's material is urgently needed for housing and
+                    // such things
+                    ship->setDead();
+                }
+                else if(shipInfo.shipType == ShipTypeEnum::ST_FLEET)
+                {
+                    // does it contain a colony?
+                    if(ship->fleetContainsShipType(ShipTypeEnum::ST_COLONY))
                     {
-                        setIsleOwnerById(isleInfo.id, shipInfo.owner, shipInfo.color);
+                        setIsleOwnerById(isleInfo.id, shipInfo.owner);
                         shipLandOnIsle(ship, isleInfo.id);
-                        // colony ships get destroyed as they land, because
-                        // the ship's material is urgently needed for housing and
-                        // such things
-                        ship->setDead();
-                    }
-                    else if(shipInfo.shipType == ShipTypeEnum::ST_FLEET)
-                    {
-                        // does it contain a colony?
-                        if(ship->fleetContainsShipType(ShipTypeEnum::ST_COLONY))
-                        {
-                            setIsleOwnerById(isleInfo.id, shipInfo.owner, shipInfo.color);
-                            shipLandOnIsle(ship, isleInfo.id);
-                            // delete the first colony ship in the fleet
-                            ship->fleetRemoveFirstColonyShip();
-                        }
-                        else
-                        {
-                            ship->landOnIsle(target.id, target.pos);
-                            ship->setPositionType(ShipPositionEnum::SP_PATROL);
-                        }
+                        // delete the first colony ship in the fleet
+                        ship->fleetRemoveFirstColonyShip();
                     }
                     else
                     {
-                        // send to orbit
                         ship->landOnIsle(target.id, target.pos);
                         ship->setPositionType(ShipPositionEnum::SP_PATROL);
                     }
                 }
-                else if(isleInfo.owner == shipInfo.owner)
-                {   // own isle
-                    // courier takes tech first
-                    ship->setCarryTechnology(isleInfo.technology);
-                    shipLandOnIsle(ship, isleInfo.id);
-                }
                 else
-                {   // enemy isle -> fight
-
-                    qInfo() << "ship fights... id= " << ship->id();
-                    // 1. fight isles patrol
-                    shipFightIslePatol(ship, target.id);
-
-                    // 2. fight isle
-                    if( shipFightIsle(ship, target.id) )
-                    {   // ship has won, isle is now owned by ship's owner
-                        shipLandOnIsle(ship, target.id);
-
-                        // every other enemy ship on this isle is now owned by the winner
-                        float local_tech_max = 0.1f;
-                        for(Ship *isleShip : m_ships)
-                        {
-                            ShipInfo isleShipInfo = isleShip->info();
-                            if(isleShipInfo.posType == ShipPositionEnum::SP_ONISLE and
-                               isleShipInfo.isleId == target.id)
-                            {   // set new owner
-                                isleShip->setOwner(shipInfo.owner, shipInfo.color);
-                                // find the maximum technology for pirated ships
-                                local_tech_max = isleShipInfo.technology > local_tech_max ? isleShipInfo.technology : local_tech_max;
-                            }
-                            if(local_tech_max > shipInfo.technology)
-                            {   // maybe, one of the pirated ships has higher tech than the ship which landed
-                                int isleIndex = isleIndexForId(target.id);
-                                if(isleIndex >= 0)
-                                    m_isles[isleIndex]->setMaxTechnology(local_tech_max);
-                            }
-                        }
+                {
+                    // send to orbit
+                    ship->landOnIsle(target.id, target.pos);
+                    ship->setPositionType(ShipPositionEnum::SP_PATROL);
+                }
+            }
+            else if(isleInfo.owner == shipInfo.owner)
+            {   // own isle
+                // courier takes tech first
+                ship->setCarryTechnology(isleInfo.technology);
+                shipLandOnIsle(ship, isleInfo.id);
+            }
+            else
+            {   // enemy isle -> fight
+
+                // 1. fight isles patrol
+                shipFightIslePatol(ship, target.id);
+
+                // 2. fight isle
+                if( shipFightIsle(ship, target.id) )
+                {   // ship has won, isle is now owned by ship's owner
+                    shipLandOnIsle(ship, target.id);
+
+                    // every other enemy ship on this isle is now owned by the winner
+                    float local_tech_max = 0.1f;
+                    int isleIndex = isleIndexForId(target.id);
+                    Q_ASSERT(isleIndex >= 0);
+                    Isle *isle = m_isles[isleIndex];
+                    for(Ship *isleShip = isle->shipsOnIsle().first(); isleShip; isleShip = isleShip->nextInGarrison())
+                    {   // set new owner
+                        isleShip->setOwner(shipInfo.owner);
+                        // find the maximum technology for pirated ships
+                        float isleShipTech = isleShip->info().technology;
+                        local_tech_max = isleShipTech > local_tech_max ? isleShipTech : local_tech_max;
                     }
-                    else
-                    {
-                        qInfo()  << "ship lost id = " << ship->id();
-                        ShipInfo info = ship->info();
-                        qInfo()  << "ship lost id = " << ship->id() << " damage: " << info.damage <<
-                                    " delete: " << (info.posType == ShipPositionEnum::SP_TRASH);
+                    if(local_tech_max > shipInfo.technology)
+                    {   // maybe, one of the pirated ships has higher tech than the ship which landed
+                        isle->setMaxTechnology(local_tech_max);
                     }
                 }
             }
-            else if(target.tType == Target::TargetEnum::T_SHIP)
-            {   // fight or rendez vous
+        }
+        else if(target.tType == Target::TargetEnum::T_SHIP)
+        {   // fight or rendez vous
 
-                // find the other ship
-                Ship *otherShip;
+            // find the other ship
+            Ship *otherShip;
 
-                int shipIndex = shipIndexForId(target.id);
-                if(shipIndex >= 0)
-                    otherShip = m_ships[shipIndex];
+            int shipIndex = shipIndexForId(target.id);
+            if(shipIndex >= 0)
+                otherShip = m_ships[shipIndex];
 
-                ShipInfo otherShipInfo = otherShip->info();
+            ShipInfo otherShipInfo = otherShip->info();
 
-                if(shipInfo.owner == otherShipInfo.owner)
-                {   // same owner: just rendez vous
-                    // @fixme: maybe add to fleet?
-                    ship->setTargetFinished();
-                }
-                else
-                {   // different owner -> fight
-                    shipFightShip(ship, otherShip);
-                    shipInfo = ship->info();    // update info
-                    if(shipInfo.posType != ShipPositionEnum::SP_TRASH)
-                        ship->setTargetFinished();
-                }
-            }
-            else // Target::TargetEnum::T_WATER
-            {
-                // nothing to do here
+            if(shipInfo.owner == otherShipInfo.owner)
+            {   // same owner: just rendez vous
+                // @fixme: maybe add to fleet?
                 ship->setTargetFinished();
             }
+            else
+            {   // different owner -> fight
+                shipFightShip(ship, otherShip);
+                shipInfo = ship->info();    // update info
+                if(shipInfo.posType != ShipPositionEnum::SP_TRASH)
+                    ship->setTargetFinished();
+            }
         }
-        else    // ship's nextround() returned false
+        else // Target::TargetEnum::T_WATER
         {
-            // repair ships on isle
-            if(shipInfo.posType == ShipPositionEnum::SP_ONISLE and (!ship->isDead()))
-            {
-                ship->repair();
-            }
+            // nothing to do here
+            ship->setTargetFinished();
         }
     }
+}
+
 
-    // empty trash
-    for(Ship *deleteThatShip : m_ships)
+void Universe::cleanupNextRound()
+{
+    // empty trash. deleteShip() leaves tombstones in m_ships, which get removed all at once below
+    for(int trashIndex = 0; trashIndex < m_ships.count(); trashIndex++)
     {
+        Ship *deleteThatShip = m_ships.at(trashIndex);
         ShipInfo dmgShipInfo = deleteThatShip->info();
 
         if(dmgShipInfo.shipType == ShipTypeEnum::ST_FLEET)
             deleteThatShip->updateFleet();
 
-        bool shouldDelete = false;
+        bool shouldDelete = deleteThatShip->isDead();
         bool doDelete = false;
-        if(deleteThatShip->isDead())
-        {
-            qDebug() << " -- should delete: " << dmgShipInfo.id;
-            shouldDelete = true;
-
-        }
         if(deleteThatShip->positionType() == ShipPositionEnum::SP_TRASH)
         {
-            qDebug() << " -- delete " << dmgShipInfo.id;
+            WW_LOG_EVENT(m_eventLog, CAT_TRASH, EV_SHIP_DELETED, 0, dmgShipInfo.id, dmgShipInfo.owner,
+                         dmgShipInfo.shipType, dmgShipInfo.damage);
             deleteShip(deleteThatShip->id());
             doDelete = true;
         }
         Q_ASSERT(shouldDelete == doDelete);
     }
+    compactShips();
 
 
-    // update the target position for ships with tType T_SHIP, because they could have moved
-    // this is very straight forward (for every ship check target ships and update pos or delete target entry)
-    // but it is worse in the meaning of complexity O(n^4) :-(
-    for( Ship *updateShip : m_ships )
+    // update the target position for ships with tType T_SHIP, because they could have moved.
+    // Only real pursuers are touched. Ships deleted by deleteShip() are no targets any more,
+    // but members of a fleet get deleted by the fleet itself.
+    QVector<uint> deadTargets;
+    const QHash<uint, QVector<Ship*> > & pursuits = m_worldIndex.pursuers.allPursuits();
+    for(QHash<uint, QVector<Ship*> >::const_iterator it = pursuits.constBegin(); it != pursuits.constEnd(); ++it)
     {
-        QVector<Target> targets = updateShip->targets();
-        for(Target t : targets)
+        int shipIndex = shipIndexForId(it.key());
+        if(shipIndex < 0)
         {
-            if(t.tType == Target::T_SHIP)
-            {
-                bool targetIsAlive = false;
-                int shipIndex = shipIndexForId(t.id);
-                if(shipIndex >= 0)
-                {
-                    targetIsAlive = true;
-                    QPointF newPos = m_ships.at(shipIndex)->info().pos;
-                    updateShip->updateTargetPos(t.id, newPos);
-                }
-
-                if(! targetIsAlive)
-                {
-                    // the target ship was deleted, so delete the target too
-                    updateShip->removeTargetShip(t.id);
-                }
-            }
+            deadTargets.append(it.key());
+            continue;
         }
+        QPointF newPos = m_ships.at(shipIndex)->pos();
+        for(Ship *pursuer : it.value())
+            pursuer->updateTargetPos(it.key(), newPos);
     }
-
-    qInfo() << "END NEXTROUND ==================";
+    // the target ship was deleted, so delete the target too
+    for(uint targetId : deadTargets)
+        for(Ship *pursuer : m_worldIndex.pursuers.pursuers(targetId))
+            pursuer->removeTargetShip(targetId);
 }
 
 
@@ -537,23 +614,24 @@ void Universe::callInfoScreen(const InfoscreenPageEnum inPage, const uint inId)
 
 void Universe::createIsles(const qreal inUniverseWidth, const qreal inUniverseHeight, const uint inNumIsles)
 {
-    srand(time(NULL));
-
     const uint maxWidth = (uint) inUniverseWidth;
     const uint maxHeight = (uint) inUniverseHeight;
 
     qreal x, y;
     bool tooClose = true;  // pos is too close to another isle
+    QVector<SpatialGrid::Item> closeIsles;
     for(uint i = 0; i < inNumIsles; i++)
     {
         do
         {
-            x = rand() % maxWidth;      // random pos
-            y = rand() % maxHeight;
+            x = m_random.bounded(maxWidth);      // random pos
+            y = m_random.bounded(maxHeight);
             tooClose = false;
-            for(Isle *isla : m_isles)
+            closeIsles.clear();
+            m_isleGrid.itemsInRange(QPointF(x, y), 50.0f, closeIsles);
+            for(const SpatialGrid::Item & isla : closeIsles)
             {
-                QPointF p = isla->pos() - QPointF(x, y);
+                QPointF p = isla.pos - QPointF(x, y);
                 if(p.manhattanLength() < 50.0f)     // |p.x| + |p.y| < 50 is too close
                 {
                     tooClose = true;
@@ -562,16 +640,18 @@ void Universe::createIsles(const qreal inUniverseWidth, const qreal inUniverseHe
             }
         } while(tooClose);
 
-        Isle *isle = new Isle(m_lastInsertedId++, Player::PLAYER_UNSETTLED, QPointF(x, y), Player::colorForOwner(Player::PLAYER_UNSETTLED));
+        Isle *isle = new Isle(&m_worldIndex, m_lastInsertedId++, Player::PLAYER_UNSETTLED, QPointF(x, y));
         m_isles.append(isle);
+        m_isleIndex.insert(isle->id(), m_isles.count() - 1);
+        m_isleGrid.insert(isle->id(), isle->pos());
     }
 }
 
 
-void Universe::createShipOnIsle(UniverseScene *& inOutUniverseScene, const IsleInfo isleInfo)
+void Universe::createShipOnIsle(const IsleInfo isleInfo)
 {
-    Ship *s = new Ship(inOutUniverseScene, isleInfo.shipToBuild, m_lastInsertedId++, isleInfo.owner,
-                       isleInfo.pos, isleInfo.color, ShipPositionEnum::SP_ONISLE,
+    Ship *s = new Ship(&m_worldIndex, isleInfo.shipToBuild, m_lastInsertedId++, isleInfo.owner,
+                       isleInfo.pos, ShipPositionEnum::SP_ONISLE,
                        isleInfo.id, isleInfo.technology);
     // default target
     switch(isleInfo.defaultTargetType)
@@ -586,6 +666,7 @@ void Universe::createShipOnIsle(UniverseScene *& inOutUniverseScene, const IsleI
             break;
     }
     m_ships.push_back(s);
+    m_shipIndex.insert(s->id(), m_ships.count() - 1);
 }
 
 
@@ -597,17 +678,24 @@ void Universe::shipFightShip(Ship *& inOutAttacker, Ship *& inOutDefender)
     // one of them is already dead
     if(inOutAttacker->isDead() or inOutDefender->isDead())
         return;
+    WW_PROFILE_COUNT(m_roundProfile, CT_FIGHTS, 1);
 
     if(info1.shipType == ShipTypeEnum::ST_COLONY or
             info1.shipType == ShipTypeEnum::ST_COURIER)
     {
         inOutAttacker->setDead();
+        WW_LOG_EVENT(m_eventLog, CAT_FIGHTS, EV_FIGHT_SHIP, EventLog::FR_DEFENDER_WON,
+                     info1.id, info2.id, info1.owner, 0.0f);
+        m_statsRecorder.countFight(info1.owner, info2.owner, EventLog::FR_DEFENDER_WON);
         return; // just attacker dies
     }
     if(info2.shipType == ShipTypeEnum::ST_COLONY or
             info2.shipType == ShipTypeEnum::ST_COURIER)
     {
         inOutDefender->setDead();
+        WW_LOG_EVENT(m_eventLog, CAT_FIGHTS, EV_FIGHT_SHIP, EventLog::FR_ATTACKER_WON,
+                     info1.id, info2.id, info1.owner, inOutAttacker->force());
+        m_statsRecorder.countFight(info1.owner, info2.owner, EventLog::FR_ATTACKER_WON);
         return; // just defender dies
     }
 
@@ -615,36 +703,46 @@ void Universe::shipFightShip(Ship *& inOutAttacker, Ship *& inOutDefender)
     float force1 = inOutAttacker->force() * 1.001f;
     float force2 = inOutDefender->force();
 
+    EventLog::FightResultEnum result;
     if(force1 > force2)
     {   // Attacker has won
         inOutAttacker->takeDamage(force2);
         inOutDefender->setDead();
+        result = EventLog::FR_ATTACKER_WON;
     }
     else if(force2 > force1)
     {   // defender has won
         inOutDefender->takeDamage(force1);
         inOutAttacker->setDead();
+        result = EventLog::FR_DEFENDER_WON;
     }
     else
     {
         // both forces are the same --> both die
         inOutAttacker->setDead();
         inOutDefender->setDead();
+        result = EventLog::FR_BOTH_DIED;
     }
+    WW_LOG_EVENT(m_eventLog, CAT_FIGHTS, EV_FIGHT_SHIP, result, info1.id, info2.id, info1.owner, force1);
+    m_statsRecorder.countFight(info1.owner, info2.owner, result);
 }
 
 
 void Universe::shipFightIslePatol(Ship *& inOutAttacker, const uint inIsleId)
 {
-    for(Ship *defender : m_ships)
-    {
-        ShipInfo defenderInfo = defender->info();
+    int isleIndex = isleIndexForId(inIsleId);
+    if(isleIndex < 0)
+        return;
 
+    // losers leave the patrol while we fight, so work on a copy. Fight in order of
+    // creation (as ids grow), not in the order the ships joined the patrol
+    QVector<Ship*> patrol = m_isles[isleIndex]->patrolShips().ships();
+    std::sort(patrol.begin(), patrol.end(),
+              [](Ship *a, Ship *b) { return a->id() < b->id(); });
+    for(Ship *defender : patrol)
+    {
         // for unowned isles we check, that there is no friendly fire
-        ShipInfo attackerInfo = inOutAttacker->info();
-        if(defenderInfo.posType == ShipPositionEnum::SP_PATROL and
-                defenderInfo.isleId == inIsleId and
-           attackerInfo.owner != defenderInfo.owner)
+        if(inOutAttacker->info().owner != defender->info().owner)
             shipFightShip(inOutAttacker, defender);
     }
 }
@@ -656,6 +754,7 @@ bool Universe::shipFightIsle(Ship *& inOutAttacker, const uint inIsleId)
 
     if(inOutAttacker->isDead())
         return false;
+    WW_PROFILE_COUNT(m_roundProfile, CT_FIGHTS, 1);
 
     ShipInfo info1 = inOutAttacker->info();
     int isleIndex = isleIndexForId(inIsleId);
@@ -668,6 +767,9 @@ bool Universe::shipFightIsle(Ship *& inOutAttacker, const uint inIsleId)
     if(info1.shipType == ShipTypeEnum::ST_COLONY or info1.shipType == ShipTypeEnum::ST_COURIER)
     {
         inOutAttacker->setDead();
+        WW_LOG_EVENT(m_eventLog, CAT_FIGHTS, EV_FIGHT_ISLE, EventLog::FR_DEFENDER_WON,
+                     info1.id, info2.id, info1.owner, 0.0f);
+        m_statsRecorder.countFight(info1.owner, info2.owner, EventLog::FR_DEFENDER_WON);
         return false;
     }
 
@@ -687,12 +789,18 @@ bool Universe::shipFightIsle(Ship *& inOutAttacker, const uint inIsleId)
 
         if(inOutAttacker->isDead())
         {   // isle is now empty without owner
-            setIsleOwnerById(info2.id, Player::PLAYER_UNSETTLED, Player::colorForOwner(Player::PLAYER_UNSETTLED));
+            setIsleOwnerById(info2.id, Player::PLAYER_UNSETTLED);
+            WW_LOG_EVENT(m_eventLog, CAT_FIGHTS, EV_FIGHT_ISLE, EventLog::FR_BOTH_DIED,
+                         info1.id, info2.id, info1.owner, force1);
+            m_statsRecorder.countFight(info1.owner, info2.owner, EventLog::FR_BOTH_DIED);
             return false;   // ship is too damaged
         }
         else
         {   // ship is alive
-            setIsleOwnerById(info2.id, info1.owner, info1.color);
+            setIsleOwnerById(info2.id, info1.owner);
+            WW_LOG_EVENT(m_eventLog, CAT_FIGHTS, EV_FIGHT_ISLE, EventLog::FR_ATTACKER_WON,
+                         info1.id, info2.id, info1.owner, force1);
+            m_statsRecorder.countFight(info1.owner, info2.owner, EventLog::FR_ATTACKER_WON);
             return true;
         }
 
@@ -701,11 +809,17 @@ bool Universe::shipFightIsle(Ship *& inOutAttacker, const uint inIsleId)
     {   // isle has won
         inOutAttacker->setDead();
         m_isles[isleIndex]->takeDamage(force1);
+        WW_LOG_EVENT(m_eventLog, CAT_FIGHTS, EV_FIGHT_ISLE, EventLog::FR_DEFENDER_WON,
+                     info1.id, info2.id, info1.owner, force1);
+        m_statsRecorder.countFight(info1.owner, info2.owner, EventLog::FR_DEFENDER_WON);
     }
     else
     {   // magic, if this happens: both forces are the same
         inOutAttacker->setDead();
-        setIsleOwnerById(info2.id, Player::PLAYER_UNSETTLED, Player::colorForOwner(Player::PLAYER_UNSETTLED));
+        setIsleOwnerById(info2.id, Player::PLAYER_UNSETTLED);
+        WW_LOG_EVENT(m_eventLog, CAT_FIGHTS, EV_FIGHT_ISLE, EventLog::FR_BOTH_DIED,
+                     info1.id, info2.id, info1.owner, force1);
+        m_statsRecorder.countFight(info1.owner, info2.owner, EventLog::FR_BOTH_DIED);
     }
 
     return false;   // ship has lost
@@ -751,8 +865,12 @@ void Universe::shipLandOnIsle(Ship *& inOutShipToLand, const uint inIsleId)
 void Universe::isleForPoint(const QPointF inScenePoint, IsleInfo & outIsleInfo)
 {
     outIsleInfo.id = 0;
-    for(Isle* isle : m_isles)
+    // isles don't overlap, so there is at most one hit
+    QVector<SpatialGrid::Item> candidates;
+    m_isleGrid.itemsInRange(inScenePoint, Isle::RADIUS, candidates);
+    for(const SpatialGrid::Item & item : candidates)
     {
+        Isle *isle = m_isles.at(isleIndexForId(item.id));
         if(isle->pointInIsle(inScenePoint))
         {
             outIsleInfo = isle->info();
@@ -764,46 +882,20 @@ void Universe::isleForPoint(const QPointF inScenePoint, IsleInfo & outIsleInfo)
 
 int Universe::isleIndexForId(const uint inIsleId) const
 {
-    int upperIndex = m_isles.count() - 1;
-    int midIndex = upperIndex / 2;
-    int lowerIndex = 0;
-    bool found = false;
-    while(! found)
-    {
-        uint id = m_isles.at(midIndex)->id();
-        if(id < inIsleId)
-        {
-            lowerIndex = midIndex + 1;
-            midIndex = (lowerIndex + upperIndex) / 2;
-        }
-        else if(id > inIsleId)
-        {
-            upperIndex = midIndex - 1;
-            midIndex = (lowerIndex + upperIndex) / 2;
-        }
-        else
-        {   // equal
-            found = true;
-        }
-        if(lowerIndex > upperIndex)
-            break;
-    }
-    if(found)
-        return midIndex;
-    else
-    {
-        // this did not happen during lots of tests, so everything looks good here
-        Q_ASSERT(false);
-        return -1;
-    }
+    WW_PROFILE_COUNT(m_roundProfile, CT_LOOKUPS, 1);
+    return m_isleIndex.slot(inIsleId);
 }
 
 
-void Universe::setIsleOwnerById(const uint inIsleId, const uint inNewOwner, const QColor inNewColor)
+void Universe::setIsleOwnerById(const uint inIsleId, const uint inNewOwner)
 {
     int isleIndex = isleIndexForId(inIsleId);
     if(isleIndex >= 0)
-        m_isles[isleIndex]->setOwner(inNewOwner, inNewColor);
+    {
+        if(inNewOwner != Player::PLAYER_UNSETTLED and m_isles[isleIndex]->info().owner != inNewOwner)
+            WW_PROFILE_COUNT(m_roundProfile, CT_CAPTURES, 1);
+        m_isles[isleIndex]->setOwner(inNewOwner);
+    }
 }
 
 
@@ -817,13 +909,20 @@ void Universe::setIslePopulationById(const uint inIsleId, const float inNewPopul
 
 int Universe::shipIndexForPoint(const QPointF inScenePoint) const
 {
-    for(int index = 0; index < m_ships.count(); index++)
+    QVector<SpatialGrid::Item> candidates;
+    m_worldIndex.shipGrid.itemsInRange(inScenePoint, Ship::HALF_WIDTH, candidates);
+
+    // ships may overlap, then the first one in m_ships wins
+    int foundIndex = -1;
+    for(const SpatialGrid::Item & item : candidates)
     {
-        Ship *s = m_ships.at(index);
-        if(s->pointInShip(inScenePoint))
-            return index;
+        int index = shipIndexForId(item.id);
+        if(index < 0 or (foundIndex >= 0 and index > foundIndex))
+            continue;   // member of a fleet or not first
+        if(m_ships.at(index)->pointInShip(inScenePoint))
+            foundIndex = index;
     }
-    return -1;
+    return foundIndex;
 }
 
 
@@ -854,72 +953,73 @@ void Universe::shipForPoint(const QPointF inScenePoint, ShipInfo & outShipInfo)
 
 int Universe::shipIndexForId(const uint inShipId) const
 {
-    int upperIndex = m_ships.count() - 1;
-    int midIndex = upperIndex / 2;
-    int lowerIndex = 0;
-    while(lowerIndex <= upperIndex)
-    {
-        uint id = m_ships.at(midIndex)->id();
-        if(id < inShipId)
-        {
-            lowerIndex = midIndex + 1;
-            midIndex = (lowerIndex + upperIndex) / 2;
-        }
-        else if(id > inShipId)
-        {
-            upperIndex = midIndex - 1;
-            midIndex = (lowerIndex + upperIndex) / 2;
-        }
-        else
-        {   // equal
-            return midIndex;
-        }
-    }
-    return -1;
+    WW_PROFILE_COUNT(m_roundProfile, CT_LOOKUPS, 1);
+    return m_shipIndex.slot(inShipId);
 }
 
 
 void Universe::deleteShip(const uint inShipId)
 {
-    Ship *shipToDelete = 0;
-
-    for(Ship *s : m_ships)
-    {
-        // for every other ship: if this ship has target ship with
-        // id inShipId, then remove the target
-
-        ShipInfo shipInfo = s->info();
-        if(shipInfo.hasTarget and shipInfo.id != inShipId)
-        {
-            // @fixme: we call really every other's ship deleteTargetShip() method, expensive!
-            s->removeTargetShip(inShipId);
-        }
+    int shipIndex = shipIndexForId(inShipId);
+    Ship *shipToDelete = shipIndex >= 0 ? m_ships.at(shipIndex) : 0;
 
-        if(s->id() == inShipId)
-            shipToDelete = s;
-    }
+    // every ship pursuing this ship loses its target. removeTargetShip() changes
+    // the pursuer index, so we work on a copy of the pursuers
+    QVector<Ship*> pursuers = m_worldIndex.pursuers.pursuers(inShipId);
+    for(Ship *s : pursuers)
+        s->removeTargetShip(inShipId);
 
     Q_ASSERT(shipToDelete);
+    WW_PROFILE_COUNT(m_roundProfile, CT_DELETIONS, 1);
     if(shipToDelete->info().shipType == ShipTypeEnum::ST_FLEET)
         shipToDelete->deleteFleetContent(shipToDelete); // delete your content
 
-    // now, no other ship has target ship with id inShipId
-    m_ships.removeOne(shipToDelete);
+    // now, no other ship has target ship with id inShipId.
+    // Leave a tombstone, compactShips() closes all gaps at once
+    m_ships[shipIndex] = 0;
+    m_shipIndex.remove(inShipId);
     delete shipToDelete;
 }
 
 
+void Universe::compactShips()
+{
+    int to = 0;
+    for(int from = 0; from < m_ships.count(); from++)
+    {
+        Ship *s = m_ships.at(from);
+        if(s == 0)
+            continue;
+        if(to != from)
+        {
+            m_ships[to] = s;
+            m_shipIndex.setSlot(s->id(), to);
+        }
+        to++;
+    }
+    while(m_ships.count() > to)
+        m_ships.removeLast();
+}
+
+
 void Universe::showHumanIsle(const IsleInfo inIsleInfo)
 {
     QList<ShipInfo> sList;
 
-    for(Ship *ship : m_ships)
+    int isleIndex = isleIndexForId(inIsleInfo.id);
+    if(isleIndex >= 0)
     {
-        ShipInfo info = ship->info();
-        if(info.owner == Player::PLAYER_HUMAN and
-                (info.posType != ShipPositionEnum::SP_OCEAN) and
-                info.isleId == inIsleInfo.id)
-            sList.append(info);
+        Isle *isle = m_isles[isleIndex];
+        for(GarrisonList *garrison : {&isle->shipsOnIsle(), &isle->patrolShips()})
+            for(Ship *ship = garrison->first(); ship; ship = ship->nextInGarrison())
+            {
+                ShipInfo info = ship->info();
+                if(info.owner == Player::PLAYER_HUMAN)
+                    sList.append(info);
+            }
+        // keep the list in order of creation, as ids grow
+        std::sort(sList.begin(), sList.end(),
+                  [](const ShipInfo & a, const ShipInfo & b) { return a.id < b.id; });
     }
 
     emit sigShowInfoHumanIsle(inIsleInfo, sList);
@@ -928,49 +1028,34 @@ void Universe::showHumanIsle(const IsleInfo inIsleInfo)
 
 void Universe::prepareStrategies()
 {
-    bool playerIsAlive = true;
+    // only objects, which changed since the last round, get copied. Once for all players.
+    QList<uint> changedIsles;
+    QList<uint> changedShips;
+    WorldDelta delta;
+    m_worldIndex.changes.take(changedIsles, changedShips, delta.destroyedShips);
+
+    for(uint isleId : changedIsles)
+    {
+        int isleIndex = isleIndexForId(isleId);
+        if(isleIndex >= 0)
+            delta.isles.append(m_isles.at(isleIndex)->info());
+    }
+    for(uint shipId : changedShips)
+    {
+        int shipIndex = shipIndexForId(shipId);
+        if(shipIndex < 0)
+            continue;
+        ExtendedShipInfo fullInfo;
+        fullInfo.shipInfo = m_ships.at(shipIndex)->info();
+        fullInfo.targets = m_ships.at(shipIndex)->targets();
+        delta.ships.append(fullInfo);
+    }
+
     for(ComputerPlayer *player : m_computerPlayers)
     {
         if(player->isDead())
             continue;
-
-        QList<IsleInfo> isleInfosPublic;
-        QList<IsleInfo> isleInfosPrivate;
-
-        for(Isle *isle : m_isles)
-        {
-            IsleInfo isleInfo = isle->info();
-            if(isleInfo.owner == player->owner())
-                isleInfosPrivate.append(isleInfo);
-            else
-                isleInfosPublic.append(isleInfo);
-        }
-
-        playerIsAlive = isleInfosPrivate.count() > 0;
-        player->setIsles(isleInfosPublic, isleInfosPrivate);
-
-        QList<ShipInfo> shipInfosPublic;
-        QList<ExtendedShipInfo> shipInfosPrivate;
-
-        for(Ship *ship : m_ships)
-        {
-            ShipInfo shipInfo = ship->info();
-            if(shipInfo.owner == player->owner())
-            {
-                ExtendedShipInfo fullInfo;
-                fullInfo.shipInfo = shipInfo;
-                fullInfo.targets = ship->targets();
-                shipInfosPrivate.append(fullInfo);
-            }
-            else
-            {
-                if(shipInfo.posType == ShipPositionEnum::SP_OCEAN)
-                    // just append if visible to everyone
-                    shipInfosPublic.append(shipInfo);
-            }
-        }
-        playerIsAlive = playerIsAlive and shipInfosPrivate.count() > 0;
-        player->setShips(shipInfosPublic, shipInfosPrivate);
+        player->applyDelta(delta);
     }
 }
 
@@ -979,91 +1064,132 @@ void Universe::processStrategyCommands(const uint inOwner, const QList<ComputerM
 {
     if(inComputerMoves.isEmpty())
         return;
+    // build ship commands have no target, they log the ship type instead. Target
+    // list commands log their index
+    auto logCommand = [&](const ComputerMove & inCmd, const bool inAccepted)
+    {
+        uint target = inCmd.targetId;
+        if(inCmd.moveType == ComputerMove::MT_ISLE_BUILD_SHIPTYPE)
+            target = (uint) inCmd.shipTypeToBuild;
+        else if(inCmd.moveType == ComputerMove::MT_SHIP_REMOVE_TARGETS or
+                inCmd.moveType == ComputerMove::MT_SHIP_SET_CYCLE_TARGETS)
+            target = (uint) inCmd.index;
+        if(inAccepted)
+            WW_LOG_EVENT(m_eventLog, CAT_COMMANDS, EV_COMMAND_ACCEPTED, inCmd.moveType, inOwner, inCmd.sourceId, target, 0.0f);
+        else
+            WW_LOG_EVENT(m_eventLog, CAT_COMMANDS, EV_COMMAND_REJECTED, inCmd.moveType, inOwner, inCmd.sourceId, target, 0.0f);
+    };
+    // the source ship of a ship command, 0 if it is gone or not ours
+    auto ownShip = [&](const uint inShipId) -> Ship*
+    {
+        int shipIndex = shipIndexForId(inShipId);
+        if(shipIndex < 0 or m_ships.at(shipIndex)->owner() != inOwner)
+            return 0;
+        return m_ships.at(shipIndex);
+    };
+    // same for isles
+    auto ownIsle = [&](const uint inIsleId) -> Isle*
+    {
+        int isleIndex = isleIndexForId(inIsleId);
+        if(isleIndex < 0 or m_isles.at(isleIndex)->info().owner != inOwner)
+            return 0;
+        return m_isles.at(isleIndex);
+    };
+
+    bool shipsRemoved = false;   // deleted or joined a fleet
     for(ComputerMove cmd : inComputerMoves)
     {
+        bool accepted = false;
         switch(cmd.moveType)
         {
             case ComputerMove::MT_ISLE_ALL_SHIPS_TO_PATROL:
             {
-                qInfo() << "Strategy, MT_ISLE_ALL_SHIPS_TO_PATROL: " << cmd.sourceId;
-                IsleInfo isleInfo;
-                isleForId(cmd.sourceId, isleInfo);
-                if(isleInfo.id > 0 and isleInfo.owner == inOwner)
+                Isle *isle = ownIsle(cmd.sourceId);
+                if(isle)
                 {
                     // not cheating
-                    for(Ship *s : m_ships)
+                    // ships move to the patrol list, so work on a copy
+                    QVector<Ship*> onIsle = isle->shipsOnIsle().ships();
+                    for(Ship *s : onIsle)
                     {
                         ShipInfo sInfo = s->info();
-                        if(s->positionType() == ShipPositionEnum::SP_ONISLE and
-                                sInfo.isleId == cmd.sourceId and
-                                (sInfo.shipType == ShipTypeEnum::ST_BATTLESHIP or
-                                 (sInfo.shipType == ShipTypeEnum::ST_FLEET and s->force() >= 1.0)))
+                        if(sInfo.shipType == ShipTypeEnum::ST_BATTLESHIP or
+                                (sInfo.shipType == ShipTypeEnum::ST_FLEET and s->force() >= 1.0))
                         {
                             s->setPositionType(ShipPositionEnum::SP_PATROL);
                         }
                     }
+                    accepted = true;
                 }
-                else
-                    qInfo() << ">REJECTED";
             }
                 break;
             case ComputerMove::MT_ISLE_BUILD_SHIPTYPE:
             {
-                qInfo() << "Strategy, MT_ISLE_BUILD_SHIPTYPE: isle:" << cmd.sourceId << " type: " << cmd.shipTypeToBuild;
-                int isleIndex = isleIndexForId(cmd.sourceId);
-                if(isleIndex < 0)
-                    return;
-                IsleInfo isleInfo = m_isles[isleIndex]->info();
-                if(isleInfo.id > 0 and isleInfo.owner == inOwner)
+                Isle *isle = ownIsle(cmd.sourceId);
+                if(isle)
                 {
                     // not cheating
-                    if(isleInfo.shipToBuild != cmd.shipTypeToBuild)
-                        m_isles[isleIndex]->setShipToBuild(cmd.shipTypeToBuild);
+                    if(isle->info().shipToBuild != cmd.shipTypeToBuild)
+                        isle->setShipToBuild(cmd.shipTypeToBuild);
+                    accepted = true;
+                }
+            }
+                break;
+            case ComputerMove::MT_ISLE_PICK_DEFAULT_TARGET:
+            {
+                Isle *isle = ownIsle(cmd.sourceId);
+                if(isle)
+                {
+                    IsleInfo targetIsleInfo;
+                    isleForPoint(cmd.pos, targetIsleInfo);
+                    if(targetIsleInfo.id == cmd.sourceId)
+                        // source and target isle are the same, disable default target
+                        isle->setDefaultTargetNothing();
+                    else if(targetIsleInfo.id > 0)
+                        isle->setDefaultTargetIsle(targetIsleInfo.pos, targetIsleInfo.id);
+                    else
+                        // just water (we do not allow ships as default targets)
+                        isle->setDefaultTargetWater(cmd.pos);
+                    accepted = true;
+                }
+            }
+                break;
+            case ComputerMove::MT_ISLE_REMOVE_DEFAULT_TARGET:
+            {
+                Isle *isle = ownIsle(cmd.sourceId);
+                if(isle)
+                {
+                    isle->setDefaultTargetNothing();
+                    accepted = true;
                 }
-                else
-                    qInfo() << ">REJECTED";
             }
                 break;
             case ComputerMove::MT_SHIP_SET_PATROL:
             {
-                qInfo() << "Strategy, MT_SHIP_SET_PATROL: isle:" << cmd.targetId << " source ship:" << cmd.sourceId;
-                IsleInfo isleInfo;
-                isleForId(cmd.targetId, isleInfo);
-                if(isleInfo.id > 0 and isleInfo.owner == inOwner)
+                Ship *s = ownIsle(cmd.targetId) ? ownShip(cmd.sourceId) : 0;
+                if(s)
                 {
                     // not cheating
-                    int shipIndex = shipIndexForId(cmd.sourceId);
-                    if(shipIndex < 0)
-                        return;
-                    Ship *s = m_ships[shipIndex];
-                    ShipInfo shipInfo = s->info();
-
                     // if the ship is on target isle...
                     if(s->positionType() == ShipPositionEnum::SP_ONISLE and
-                            shipInfo.isleId == cmd.targetId)
+                            s->info().isleId == cmd.targetId)
                     {
                         s->setPositionType(ShipPositionEnum::SP_PATROL);
                     }
+                    accepted = true;
                 }
-                else
-                    qInfo() << ">REJECTED";
             }
                 break;
             case ComputerMove::MT_SHIP_SET_TARGET_IMMEDIATELY:
-                qInfo() << "Strategy, MT_SHIP_SET_TARGET_IMMEDIATELY..."; // fall through
+                // fall through
             case ComputerMove::MT_SHIP_SET_TARGET:
             {
-                qInfo() << "Strategy, MT_SHIP_SET_TARGET: ship:" << cmd.sourceId << " has target:" << cmd.targetType
-                        << " with target id: " << cmd.targetId;
-                int sourceShipIndex = shipIndexForId(cmd.sourceId);
-                if(sourceShipIndex < 0)
-                    return;
-                ShipInfo sourceShipInfo = m_ships[sourceShipIndex]->info();
-                if(sourceShipInfo.owner == inOwner)
+                Ship *s = ownShip(cmd.sourceId);
+                if(s)
                 {
                     if(cmd.moveType == ComputerMove::MT_SHIP_SET_TARGET_IMMEDIATELY)
                     {
-                        m_ships[sourceShipIndex]->removeTargets();
+                        s->removeTargets();
                     }
                     switch(cmd.targetType)
                     {
@@ -1073,7 +1199,7 @@ void Universe::processStrategyCommands(const uint inOwner, const QList<ComputerM
                             shipForId(cmd.targetId, otherShipInfo);
                             if(otherShipInfo.id > 0)
                             {
-                                m_ships[sourceShipIndex]->setTargetShip(otherShipInfo.id, otherShipInfo.pos);
+                                s->setTargetShip(otherShipInfo.id, otherShipInfo.pos);
                             }
                         }
                             break;
@@ -1083,23 +1209,121 @@ void Universe::processStrategyCommands(const uint inOwner, const QList<ComputerM
                             isleForId(cmd.targetId, otherIsleInfo);
                             if(otherIsleInfo.id > 0)
                             {
-                                m_ships[sourceShipIndex]->setTargetIsle(otherIsleInfo.id, otherIsleInfo.pos);
+                                s->setTargetIsle(otherIsleInfo.id, otherIsleInfo.pos);
                             }
                         }
                             break;
                         case Target::T_WATER:
-                            m_ships[sourceShipIndex]->setTargetWater(cmd.pos);
+                            s->setTargetWater(cmd.pos);
                             break;
                         default:
                             Q_ASSERT(false);
                     }
+                    accepted = true;
                 }
-                else
-                    qInfo() << ">REJECTED";
+            }
+                break;
+            case ComputerMove::MT_SHIP_PICK_TARGET:
+            {
+                Ship *s = ownShip(cmd.sourceId);
+                if(s)
+                {
+                    IsleInfo isleInfo;
+                    isleForPoint(cmd.pos, isleInfo);
+                    ShipInfo targetShipInfo;
+                    if(isleInfo.id == 0)
+                        shipForPoint(cmd.pos, targetShipInfo);
+                    if(isleInfo.id > 0)
+                        s->setTargetIsle(isleInfo.id, isleInfo.pos);
+                    else if(targetShipInfo.id > 0 and targetShipInfo.id != cmd.sourceId)
+                        s->setTargetShip(targetShipInfo.id, targetShipInfo.pos);
+                    else
+                        s->setTargetWater(cmd.pos);
+                    accepted = true;
+                }
+            }
+                break;
+            case ComputerMove::MT_SHIP_DELETE:
+            {
+                Ship *s = ownShip(cmd.sourceId);
+                // only ships on an isle may be scrapped
+                if(s and s->positionType() != ShipPositionEnum::SP_OCEAN and s->info().isleId > 0)
+                {
+                    deleteShip(cmd.sourceId);
+                    shipsRemoved = true;
+                    accepted = true;
+                }
+            }
+                break;
+            case ComputerMove::MT_SHIP_TOGGLE_PATROL:
+            {
+                Ship *s = ownShip(cmd.sourceId);
+                if(s and s->positionType() != ShipPositionEnum::SP_OCEAN and
+                        s->positionType() != ShipPositionEnum::SP_IN_FLEET)
+                {
+                    s->removeTargets();
+                    if(s->positionType() == ShipPositionEnum::SP_ONISLE)
+                        s->setPositionType(ShipPositionEnum::SP_PATROL);
+                    else
+                        s->setPositionType(ShipPositionEnum::SP_ONISLE);
+                    accepted = true;
+                }
+            }
+                break;
+            case ComputerMove::MT_SHIP_REMOVE_TARGETS:
+            {
+                Ship *s = ownShip(cmd.sourceId);
+                if(s)
+                {
+                    if(cmd.index < 0)
+                        s->removeTargets();
+                    else
+                        s->removeTargetByIndex(cmd.index);
+                    accepted = true;
+                }
+            }
+                break;
+            case ComputerMove::MT_SHIP_SET_CYCLE_TARGETS:
+            {
+                Ship *s = ownShip(cmd.sourceId);
+                if(s)
+                {
+                    s->setCycleTargets(cmd.index != 0);
+                    accepted = true;
+                }
+            }
+                break;
+            case ComputerMove::MT_SHIP_ADD_TO_FLEET:
+            {
+                Ship *s = ownShip(cmd.sourceId);
+                if(s == 0 or cmd.targetId == cmd.sourceId)
+                    break;
+                ShipInfo shipInfo = s->info();
+                // fleets don't nest
+                if(shipInfo.shipType == ShipTypeEnum::ST_FLEET)
+                    break;
+                if(shipInfo.posType == ShipPositionEnum::SP_OCEAN or shipInfo.isleId == 0)
+                    break;
+                if(cmd.targetId > 0)
+                {   // an existing fleet, on the same isle. isleId is kept at sea, so check the position, too
+                    Ship *fleet = ownShip(cmd.targetId);
+                    if(fleet == 0 or fleet->info().shipType != ShipTypeEnum::ST_FLEET or
+                            fleet->info().isleId != shipInfo.isleId)
+                        break;
+                    if(fleet->positionType() != ShipPositionEnum::SP_ONISLE and
+                            fleet->positionType() != ShipPositionEnum::SP_PATROL)
+                        break;
+                }
+                shipAddToFleet(shipInfo.isleId, cmd.targetId, cmd.sourceId);
+                shipsRemoved = true;
+                accepted = true;
             }
                 break;
         }
+        logCommand(cmd, accepted);
     }
+    if(shipsRemoved)
+        compactShips();
 }
 
 
@@ -1127,9 +1351,9 @@ void Universe::slotUniverseViewClicked(QPointF scenePos)
         {   // human or enemy ship?
 
             // @fixme: debug
-            for(Ship *ds : m_ships)
-                if(shipInfo.id == ds->id())
-                    ds->debugReport();
+            int debugIndex = shipIndexForId(shipInfo.id);
+            if(debugIndex >= 0)
+                m_ships.at(debugIndex)->debugReport();
 
             if(shipInfo.owner == Player::PLAYER_HUMAN)
                 emit sigShowInfoHumanShip(shipInfo, targets);
@@ -1140,69 +1364,3 @@ void Universe::slotUniverseViewClicked(QPointF scenePos)
             emit sigShowInfoWater();
     }
 }
-
-
-void Universe::slotUniverseViewClickedFinishShipTarget(QPointF scenePos, uint shipId)
-{
-    // find the source ship which needs new target
-    int shipIndex = shipIndexForId(shipId);
-    Ship *sourceShip = m_ships[shipIndex];
-
-    Q_ASSERT(sourceShip);
-
-    ShipInfo sourceShipInfo = sourceShip->info();
-
-    IsleInfo isleInfo;
-    isleForPoint(scenePos, isleInfo);
-    if(isleInfo.id > 0)
-    {
-        // ship with id shipId wants target isle with id isleInfo.id
-        sourceShip->setTargetIsle(isleInfo.id, isleInfo.pos);
-    }
-    else
-    {
-        ShipInfo targetShipInfo;
-        shipForPoint(scenePos, targetShipInfo);
-        if(targetShipInfo.id > 0 and targetShipInfo.id != sourceShipInfo.id)
-        {   // target other ship
-            sourceShip->setTargetShip(targetShipInfo.id, targetShipInfo.pos);
-        }
-        else
-        {   // ship with id shipId wants target water at scenePos
-            sourceShip->setTargetWater(scenePos);
-        }
-    }
-    // call the infoscreen again, as the reason for a new target is one of 2 infoscreen-buttons
-    emit sigRecallInfoscreen();
-}
-
-
-void Universe::slotUniverseViewClickedFinishIsleTarget(QPointF scenePos, uint isleId)
-{
-    Isle *sourceIsle = 0;
-
-    // find source isle
-    int isleIndex = isleIndexForId(isleId);
-    if(isleIndex >= 0)
-        sourceIsle = m_isles[isleIndex];
-
-    Q_ASSERT(sourceIsle);
-
-    IsleInfo targetIsleInfo;
-    isleForPoint(scenePos, targetIsleInfo);
-    if(targetIsleInfo.id > 0)
-    {   // we found a target isle
-        if(targetIsleInfo.id == isleId)
-            // source and target isle are the same, disable default target
-            sourceIsle->setDefaultTargetNothing();
-        else
-            sourceIsle->setDefaultTargetIsle(targetIsleInfo.pos, targetIsleInfo.id);
-    }
-    else
-    {   // just water (we do not allow ships as default targets)
-        sourceIsle->setDefaultTargetWater(scenePos);
-    }
-
-    IsleInfo iInfo = sourceIsle->info();
-    showHumanIsle(iInfo);
-}
@@ -11,30 +11,76 @@
 #include <isle.h>
 #include <ship.h>
 #include <computerplayer.h>
-#include <universescene.h>
-#include <waterobjectinfo.h>
-
+#include <commandqueue.h>
+#include <infoscreenpage.h>
+#include <objectindex.h>
+#include <spatialgrid.h>
+#include <worldindex.h>
+#include <random.h>
+#include <roundprofile.h>
+#include <eventlog.h>
+#include <statsrecorder.h>
+#include <universesnapshot.h>
+
+#include <QObject>
 #include <QVector>
 #include <QList>
 #include <QPointF>
-
-
+#include <QThreadPool>
+#include <QMutex>
+#include <QSharedPointer>
+
+
+/**
+ * @brief The Universe class is the simulation core: isles, ships and computer players.
+ *
+ * It knows nothing about graphics. Whoever wants to display the universe (see
+ * UniverseRenderer) connects to sigUniverseChanged() and reads snapshot().
+ *
+ * The GUI moves the universe to a thread of its own. Then only snapshot(), postHumanMove()
+ * and the signals may be used from outside, everything else must be invoked queued
+ * (QMetaObject::invokeMethod()), so it runs on the simulation thread between two rounds.
+ */
 class Universe : public QObject
 {
     Q_OBJECT
 
 public:
-    explicit Universe(QObject *inParent, UniverseScene *& inOutUniverseScene, const qreal inUniverseWidth,
-                      const qreal inUniverseHeight, const uint inNumIsles, const uint numEnemies);
+    /* The same inSeed gives the same universe and, with the same moves,
+     * the same game. See Random::seedFromClock() for a fresh one. */
+    explicit Universe(QObject *inParent, const qreal inUniverseWidth,
+                      const qreal inUniverseHeight, const uint inNumIsles, const uint numEnemies,
+                      const quint64 inSeed);
 
     uint numberOfEnemies() const { return m_computerPlayers.count(); }
 
-    // delete a ship and reshow the human isle
-    void deleteShipOnIsle(const uint inShipId);
+    quint64 seed() const { return m_random.seed(); }
+
+    // timing and counters of the last nextRound()
+    const RoundProfile & lastRoundProfile() const { return m_lastRoundProfile; }
+
+    // print the profile after each round, off by default
+    void setPrintProfile(const bool inPrintProfile) { m_printProfile = inPrintProfile; }
+
+    // commands, fights and deleted ships. Off by default, see EventLog::setCategories()
+    EventLog & eventLog() { return m_eventLog; }
+
+    // per player time series, one row per round. Off by default, see StatsRecorder::start()
+    StatsRecorder & statsRecorder() { return m_statsRecorder; }
+
+    // number of rounds played so far
+    uint round() const { return m_round; }
 
-    // set ship to patrol the isle. Patrol means, this ship protects the isle
-    // and gets attacked, whenever attacks the isle
-    void setShipPatrolsIsle(const uint inShipId);
+    // read only access, only for the thread the universe lives on. See snapshot() for the others
+    const QVector<Isle*> & isles() const { return m_isles; }
+    const QList<Ship*> & ships() const { return m_ships; }
+
+    /* the last published state of the universe. Safe to call from any thread. It is
+     * only kept up to date while something is connected to sigUniverseChanged() */
+    QSharedPointer<const UniverseSnapshot> snapshot() const;
+
+    // call once before connecting queued signals of the universe
+    static void registerMetaTypes();
 
     QPointF shipPosById(const uint inShipId);
 
@@ -46,32 +92,28 @@ public:
 
     void isleForId(const uint inIsleId, IsleInfo & outIsleInfo);
 
-    void isleSetShipToBuild(const uint inIsleId, const ShipTypeEnum inShipToBuild);
-
-    // for communication with OverviewDialog (used in MainWindow::slotToggleOverviewDialog())
-    void getAllIsleInfos(QList<IsleInfo> & outIsleInfos);
-    void getAllShipInfos(QList<ShipInfo> & outShipInfos);
-
-    void removeDefaultIsleTarget(const uint inIsleId);
+    /* Orders of the human player. Safe to call from one other thread (the GUI), it
+     * never waits for the simulation. The move gets checked and applied on the
+     * simulation thread between two rounds, or at the start of a running round.
+     * False, if too many moves are waiting already. */
+    bool postHumanMove(const ComputerMove & inMove);
 
-    void removeAllShipTargets(const uint inShipId);
+    // apply the moves waiting from postHumanMove(), then publish the changes
+    Q_INVOKABLE void processHumanMoves();
 
-    void removeShipTargetByIndex(const uint inShipId, const int inIndex);
+    Q_INVOKABLE void nextRound();
 
-    void shipSetCycleTargets(const uint inShipId, const uint inCycle);
-
-    void shipAddToFleet(UniverseScene *& inOutUniverseScene, const uint inIsleId, const uint inFleetId, const uint inShipId);
-
-    void nextRound(UniverseScene *& inOutUniverseScene);
+    // fast forward: play inRounds rounds, but tell observers only once at the end
+    Q_INVOKABLE void nextRounds(const uint inRounds);
 
     // update InfoScreen after MainWindow::nextRound()
-    void callInfoScreen(const InfoscreenPageEnum inPage, const uint inId);
+    Q_INVOKABLE void callInfoScreen(const InfoscreenPageEnum inPage, const uint inId);
 
 
 private:
     void createIsles(const qreal inUniverseWidth, const qreal inUniverseHeight, const uint inNumIsles);
 
-    void createShipOnIsle(UniverseScene *& inOutUniverseScene, const IsleInfo isleInfo);
+    void createShipOnIsle(const IsleInfo isleInfo);
 
     void shipFightShip(Ship *& inOutAttacker, Ship *& inOutDefender);
 
@@ -87,6 +129,9 @@ private:
 
     void shipLandOnIsle(Ship *& inOutShipToLand, const uint inIsleId);
 
+    // checked by processStrategyCommands(), which also closes the gap in m_ships
+    void shipAddToFleet(const uint inIsleId, const uint inFleetId, const uint inShipId);
+
     /**
      * @brief isleForPoint - returns an isleInfo if we hit an isle
      * @param inScenePoint - position inside universe (scene coordinates)
@@ -96,7 +141,7 @@ private:
 
     int isleIndexForId(const uint inIsleId) const;
 
-    void setIsleOwnerById(const uint inIsleId, const uint inNewOwner, const QColor inNewColor);
+    void setIsleOwnerById(const uint inIsleId, const uint inNewOwner);
 
     void setIslePopulationById(const uint inIsleId, const float inNewPopulation);
 
@@ -108,12 +153,18 @@ private:
 
     int shipIndexForId(const uint inShipId) const;
 
-    // really delete a ship
+    // really delete a ship. This leaves a tombstone (0) in m_ships, call compactShips() afterwards
     void deleteShip(const uint inShipId);
 
+    // remove all tombstones from m_ships, keeping the order
+    void compactShips();
+
     // show an isle, prepare all data
     void showHumanIsle(const IsleInfo inIsleInfo);
 
+    // counts nextRound() calls
+    uint m_round;
+
     // is of water objects, each id of every object is unique
     uint m_lastInsertedId;
 
@@ -121,12 +172,65 @@ private:
     QVector<Isle*> m_isles;
     QList<Ship*> m_ships;
 
+    // id -> index in m_isles and m_ships, see isleIndexForId() and shipIndexForId()
+    ObjectIndex m_isleIndex;
+    ObjectIndex m_shipIndex;
+
+    // pursuers and ship positions, maintained by the ships themselves
+    WorldIndex m_worldIndex;
+
+    // position of every isle, for picking and to keep new isles apart
+    SpatialGrid m_isleGrid;
+
+    // every random decision of the universe comes from here
+    Random m_random;
+
+    // m_roundProfile gets filled during nextRound() and is copied to m_lastRoundProfile
+    // at the end. Mutable, as the const lookups count, too
+    mutable RoundProfile m_roundProfile;
+    RoundProfile m_lastRoundProfile;
+    bool m_printProfile;
+
+    EventLog m_eventLog;
+
+    StatsRecorder m_statsRecorder;
+
+    // one round without sigUniverseChanged(), see nextRound() and nextRounds()
+    void simulateRound();
+
+    // publish a new snapshot, then emit sigUniverseChanged(). Does nothing without
+    // a receiver of sigUniverseChanged() (e.g. the benchmark), once the first one is published
+    void publishChanges();
+
+    // Publishing fills a snapshot, which no reader holds, and swaps it with m_snapshot under
+    // m_snapshotMutex. When the last reader lets go of an old snapshot, it goes back to
+    // m_snapshotRecycler, so the next publishChanges() reuses its buffers.
+    mutable QMutex m_snapshotMutex;
+    QSharedPointer<const UniverseSnapshot> m_snapshot;
+    QSharedPointer<SnapshotRecycler> m_snapshotRecycler;
+
+    // the phases of nextRound(), see RoundProfile::PhaseEnum
+    void strategiesNextRound();
+    void islesNextRound();
+    void shipsNextRound();
+    void cleanupNextRound();
+
     // send isle and ship infos to strategy
     void prepareStrategies();
+    // the one place, where moves of computer players and the human get checked and applied
     void processStrategyCommands(const uint inOwner, const QList<ComputerMove> inComputerMoves);
 
+    // human moves on their way from the GUI, see postHumanMove()
+    CommandQueue m_humanMoves;
+
+    // takes the waiting human moves and applies them, false if there were none
+    bool applyHumanMoves();
+
     QVector<ComputerPlayer*> m_computerPlayers;
 
+    // computer players think in parallel, see nextRound()
+    QThreadPool m_strategyPool;
+
 
 signals:
     /* These signals match the above enum InfoscreenPage.
@@ -144,12 +248,16 @@ signals:
     void sigShowInfoHumanIsle(IsleInfo isleInfo, QList<ShipInfo> sList);
     void sigShowInfoShip(ShipInfo shipInfo);
     void sigShowInfoHumanShip(ShipInfo shipInfo, QVector<Target> targets);
-    void sigRecallInfoscreen(); // ask MainWindow to update infoscreen
+
+    // ships or isles were created, moved, deleted or changed owner.
+    // Observers (the renderer) should sync with snapshot() now.
+    void sigUniverseChanged();
+
+    // nextRound() or nextRounds() is done, after sigUniverseChanged()
+    void sigRoundFinished();
 
 public slots:
     void slotUniverseViewClicked(QPointF scenePos);
-    void slotUniverseViewClickedFinishShipTarget(QPointF scenePos, uint shipId);
-    void slotUniverseViewClickedFinishIsleTarget(QPointF scenePos, uint isleId);
 
 };
 
@@ -0,0 +1,55 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+#include <universerenderer.h>
+#include <playercolor.h>
+#include <tracerecorder.h>
+
+
+UniverseRenderer::UniverseRenderer(UniverseScene *inScene, MinimapView *inMinimap, Universe *inUniverse,
+                                   QObject *inParent)
+    : QObject(inParent), m_scene(inScene), m_minimap(inMinimap), m_universe(inUniverse)
+{
+    m_ships = new ShipBatchItem;
+    m_scene->addItem(m_ships);
+    connect(m_universe, SIGNAL(sigUniverseChanged()), this, SLOT(slotSyncScene()));
+    slotSyncScene();
+}
+
+
+void UniverseRenderer::slotSyncScene()
+{
+    WW_TRACE_SPAN("UniverseRenderer::slotSyncScene");
+    QSharedPointer<const UniverseSnapshot> snapshot = m_universe->snapshot();
+    if(snapshot.isNull() or snapshot == m_shownSnapshot)
+        return;
+    m_shownSnapshot = snapshot;
+    syncIsles(*snapshot);
+    syncShips(*snapshot);
+    if(m_minimap)
+        m_minimap->updateRaster(*snapshot);
+}
+
+
+void UniverseRenderer::syncIsles(const UniverseSnapshot & inSnapshot)
+{
+    // the scene paints isles as background and repaints only those, which changed
+    for(const IsleInfo & isle : inSnapshot.isles)
+        m_scene->setIsle(isle.id, isle.pos, PlayerColor::colorForOwner(isle.owner));
+}
+
+
+void UniverseRenderer::syncShips(const UniverseSnapshot & inSnapshot)
+{
+    m_ships->beginUpdate();
+    for(const ShipInfo & ship : inSnapshot.ships)
+    {
+        // only ships on the ocean are visible
+        if(ship.posType == ShipPositionEnum::SP_OCEAN)
+            m_ships->addShip(ship.id, ship.owner, ship.pos);
+    }
+    m_ships->endUpdate();
+}
@@ -0,0 +1,56 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+#ifndef UNIVERSERENDERER_H
+#define UNIVERSERENDERER_H
+
+
+#include <universe.h>
+#include <universescene.h>
+#include <shipbatchitem.h>
+#include <minimapview.h>
+
+#include <QObject>
+
+
+/**
+ * @brief The UniverseRenderer class displays the Universe within a UniverseScene
+ *
+ * Universe itself does not know about graphics. This class feeds isles and ships
+ * into the scene and is an observer of the universe: whenever
+ * Universe::sigUniverseChanged() is emitted, the scene items get synced with the
+ * latest Universe::snapshot(). Without a renderer, the universe runs headless.
+ */
+class UniverseRenderer : public QObject
+{
+    Q_OBJECT
+
+public:
+    // inMinimap may be 0, it gets a raster of every snapshot
+    explicit UniverseRenderer(UniverseScene *inScene, MinimapView *inMinimap, Universe *inUniverse,
+                              QObject *inParent = 0);
+
+public slots:
+    // read isles and ships from the latest snapshot and update the scene items
+    void slotSyncScene();
+
+private:
+    void syncIsles(const UniverseSnapshot & inSnapshot);
+    void syncShips(const UniverseSnapshot & inSnapshot);
+
+    UniverseScene *m_scene;
+    MinimapView *m_minimap;
+    Universe *m_universe;
+
+    // the scene shows this one. Queued signals may arrive after the next snapshot is out,
+    // then there is nothing to do for them
+    QSharedPointer<const UniverseSnapshot> m_shownSnapshot;
+
+    // all sailing ships, owned by the scene. Isles are no items, see UniverseScene
+    ShipBatchItem *m_ships;
+};
+
+#endif // UNIVERSERENDERER_H
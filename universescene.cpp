@@ -5,10 +5,117 @@
 
 
 #include "universescene.h"
+#include <isle.h>
+#include <tracerecorder.h>
+#include <math.h>
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
 
 
 UniverseScene::UniverseScene(const QRectF inRect, QObject *inParent) :
-    QGraphicsScene(inRect, inParent)
+    QGraphicsScene(inRect, inParent), m_drawCount(0)
 {
+    // the few items left (one batch item for all ships, paths) change every round,
+    // keeping a BSP tree up to date costs more than it saves
+    setItemIndexMethod(QGraphicsScene::NoIndex);
+
+    m_tileColumns = qMax(1, (int) ceil(inRect.width() / TILE_SIZE));
+    m_tileRows = qMax(1, (int) ceil(inRect.height() / TILE_SIZE));
+    m_tiles.resize(m_tileColumns * m_tileRows);
+}
+
+
+void UniverseScene::setIsle(const uint inIsleId, const QPointF inPos, const QColor inColor)
+{
+    int index = m_isleIndex.value(inIsleId, -1);
+    if(index >= 0)
+    {
+        // isles never move, but change their owner
+        if(m_isles.at(index).color == inColor)
+            return;
+        m_isles[index].color = inColor;
+    }
+    else
+    {
+        IsleShape shape;
+        shape.pos = inPos;
+        shape.color = inColor;
+        index = m_isles.count();
+        m_isles.append(shape);
+        m_isleIndex.insert(inIsleId, index);
+        m_drawnStamp.append(0);
+
+        int firstColumn, firstRow, lastColumn, lastRow;
+        tileRange(isleRect(inPos), firstColumn, firstRow, lastColumn, lastRow);
+        for(int row = firstRow; row <= lastRow; row++)
+            for(int column = firstColumn; column <= lastColumn; column++)
+                m_tiles[row * m_tileColumns + column].append(index);
+    }
+    // the views draw this part of their cached background again
+    invalidate(isleRect(inPos), QGraphicsScene::BackgroundLayer);
+}
+
+
+void UniverseScene::drawBackground(QPainter *inPainter, const QRectF & inRect)
+{
+    WW_TRACE_SPAN("UniverseScene::drawBackground");
+    QGraphicsScene::drawBackground(inPainter, inRect);
+
+    m_drawCount++;
+    if(m_drawCount == 0)
+    {   // wrapped around, forget the old stamps
+        m_drawnStamp.fill(0);
+        m_drawCount = 1;
+    }
+
+    // zoomed out, an isle is a single pixel. drawPoint() is much cheaper than drawEllipse()
+    const qreal lod = QStyleOptionGraphicsItem::levelOfDetailFromTransform(inPainter->worldTransform());
+    const bool asPoints = Isle::RADIUS * lod < ISLE_POINT_RADIUS;
+    QPen pointPen;
+    pointPen.setCosmetic(true);
+    pointPen.setWidth(2);
+    if(! asPoints)
+        inPainter->setPen(QPen());
+
+    int firstColumn, firstRow, lastColumn, lastRow;
+    tileRange(inRect, firstColumn, firstRow, lastColumn, lastRow);
+    for(int row = firstRow; row <= lastRow; row++)
+        for(int column = firstColumn; column <= lastColumn; column++)
+            for(int index : m_tiles.at(row * m_tileColumns + column))
+            {
+                if(m_drawnStamp.at(index) == m_drawCount)
+                    continue;
+                m_drawnStamp[index] = m_drawCount;
+                const IsleShape & shape = m_isles.at(index);
+                if(asPoints)
+                {
+                    pointPen.setColor(shape.color);
+                    inPainter->setPen(pointPen);
+                    inPainter->drawPoint(shape.pos);
+                }
+                else
+                {
+                    inPainter->setBrush(shape.color);
+                    inPainter->drawEllipse(shape.pos, Isle::RADIUS, Isle::RADIUS);
+                }
+            }
+}
+
+
+QRectF UniverseScene::isleRect(const QPointF inPos) const
+{
+    // one more for the outline
+    const qreal r = Isle::RADIUS + 1.0;
+    return QRectF(inPos.x() - r, inPos.y() - r, 2.0 * r, 2.0 * r);
 }
 
+
+void UniverseScene::tileRange(const QRectF & inRect, int & outFirstColumn, int & outFirstRow,
+                              int & outLastColumn, int & outLastRow) const
+{
+    const QRectF scene = sceneRect();
+    outFirstColumn = qBound(0, (int) floor((inRect.left() - scene.left()) / TILE_SIZE), m_tileColumns - 1);
+    outLastColumn = qBound(0, (int) floor((inRect.right() - scene.left()) / TILE_SIZE), m_tileColumns - 1);
+    outFirstRow = qBound(0, (int) floor((inRect.top() - scene.top()) / TILE_SIZE), m_tileRows - 1);
+    outLastRow = qBound(0, (int) floor((inRect.bottom() - scene.top()) / TILE_SIZE), m_tileRows - 1);
+}
@@ -8,13 +8,62 @@
 #define UNIVERSESCENE_H
 
 #include <QGraphicsScene>
+#include <QColor>
+#include <QHash>
+#include <QVector>
 
+/**
+ * @brief The UniverseScene class draws the isles as background, ships and paths are items
+ *
+ * Isles never move, so they are no items. drawBackground() paints them and the views
+ * keep the result (QGraphicsView::CacheBackground). A repaint of the view is then one
+ * blit of the cached background plus the items. setIsle() invalidates only the area of
+ * the isle that changed, the isles are found by tiles of TILE_SIZE. Zoomed out, isles
+ * are points.
+ */
 class UniverseScene : public QGraphicsScene
 {
     Q_OBJECT
 public:
     explicit UniverseScene(const QRectF inSceneRect, QObject *inParent = 0);
 
+    // add an isle or change its color. Cheap, if nothing changed
+    void setIsle(const uint inIsleId, const QPointF inPos, const QColor inColor);
+
+protected:
+    void drawBackground(QPainter *inPainter, const QRectF & inRect);
+
+private:
+    struct IsleShape
+    {
+        QPointF pos;
+        QColor color;
+    };
+
+    static const int TILE_SIZE = 100;
+
+    // isles smaller than this on screen (in pixels) are drawn as points
+    static constexpr qreal ISLE_POINT_RADIUS = 1.5;
+
+    // area covered by the isle, outline included
+    QRectF isleRect(const QPointF inPos) const;
+
+    // range of tiles covered by inRect, clamped to the scene
+    void tileRange(const QRectF & inRect, int & outFirstColumn, int & outFirstRow,
+                   int & outLastColumn, int & outLastRow) const;
+
+    QVector<IsleShape> m_isles;
+    QHash<uint, int> m_isleIndex;    // isle id -> index in m_isles
+
+    // indexes into m_isles, an isle is listed in every tile it touches
+    int m_tileColumns;
+    int m_tileRows;
+    QVector< QVector<int> > m_tiles;
+
+    // drawBackground() paints each isle once, even if it is in more than one tile
+    QVector<uint> m_drawnStamp;
+    uint m_drawCount;
+
 signals:
 
 public slots:
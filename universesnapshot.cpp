@@ -0,0 +1,77 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+#include <universesnapshot.h>
+
+#include <QMutexLocker>
+
+
+void UniverseSnapshot::buildIndex()
+{
+    m_isleIndex.clear();
+    m_isleIndex.reserve(isles.count());
+    for(int i = 0; i < isles.count(); i++)
+        m_isleIndex.insert(isles.at(i).id, i);
+
+    m_shipIndex.clear();
+    m_shipIndex.reserve(ships.count());
+    for(int i = 0; i < ships.count(); i++)
+        m_shipIndex.insert(ships.at(i).id, i);
+}
+
+
+const IsleInfo* UniverseSnapshot::isle(const uint inIsleId) const
+{
+    int index = m_isleIndex.value(inIsleId, -1);
+    return index < 0 ? 0 : &isles.at(index);
+}
+
+
+const ShipInfo* UniverseSnapshot::ship(const uint inShipId) const
+{
+    int index = m_shipIndex.value(inShipId, -1);
+    return index < 0 ? 0 : &ships.at(index);
+}
+
+
+SnapshotRecycler::~SnapshotRecycler()
+{
+    delete m_spare;
+}
+
+
+UniverseSnapshot* SnapshotRecycler::take()
+{
+    UniverseSnapshot *snapshot;
+    {
+        QMutexLocker locker(&m_mutex);
+        snapshot = m_spare;
+        m_spare = 0;
+    }
+    return snapshot ? snapshot : new UniverseSnapshot;
+}
+
+
+void SnapshotRecycler::release(UniverseSnapshot *inSnapshot)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        if(m_spare == 0)
+        {
+            m_spare = inSnapshot;
+            return;
+        }
+    }
+    delete inSnapshot;
+}
+
+
+QSharedPointer<const UniverseSnapshot> SnapshotRecycler::share(UniverseSnapshot *inSnapshot,
+                                                               const QSharedPointer<SnapshotRecycler> & inRecycler)
+{
+    return QSharedPointer<const UniverseSnapshot>(inSnapshot, [inRecycler](UniverseSnapshot *inReleased)
+        { inRecycler->release(inReleased); });
+}
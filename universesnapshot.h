@@ -0,0 +1,83 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+#ifndef UNIVERSESNAPSHOT_H
+#define UNIVERSESNAPSHOT_H
+
+
+#include <isle.h>
+#include <ship.h>
+#include <playerstats.h>
+
+#include <QVector>
+#include <QHash>
+#include <QMutex>
+#include <QSharedPointer>
+
+
+/**
+ * @brief The UniverseSnapshot struct is a copy of everything visible, taken after a round
+ *
+ * Universe runs on its own thread. It publishes a new snapshot whenever the universe
+ * changed, see Universe::snapshot(). A published snapshot never changes, so the GUI may
+ * read it without any locking for as long as it holds the pointer.
+ */
+struct UniverseSnapshot
+{
+    uint round;
+
+    QVector<IsleInfo> isles;    // in order of creation
+    QVector<ShipInfo> ships;
+
+    // targets of the human's ships, for the paths drawn by UniverseView
+    QHash<uint, QVector<Target> > humanShipTargets;
+
+    // isles, population, ships and force per owner, for the overview dialog
+    PlayerStats playerStats;
+
+    UniverseSnapshot() : round(0) {}
+
+    // call after filling isles and ships
+    void buildIndex();
+
+    // 0, if there is no such isle or ship
+    const IsleInfo* isle(const uint inIsleId) const;
+    const ShipInfo* ship(const uint inShipId) const;
+
+private:
+    QHash<uint, int> m_isleIndex;
+    QHash<uint, int> m_shipIndex;
+};
+
+
+/**
+ * @brief The SnapshotRecycler class keeps a released snapshot, so the next one reuses its buffers
+ *
+ * Readers release snapshots on their own thread, maybe even after the universe is gone.
+ * So the recycler is shared by the universe and by the deleter of each snapshot.
+ */
+class SnapshotRecycler
+{
+public:
+    SnapshotRecycler() : m_spare(0) {}
+    ~SnapshotRecycler();
+
+    // a released snapshot or a new one, owned by the caller
+    UniverseSnapshot* take();
+
+    // nobody reads inSnapshot anymore
+    void release(UniverseSnapshot *inSnapshot);
+
+    // share inSnapshot, the last reader hands it back to inRecycler
+    static QSharedPointer<const UniverseSnapshot> share(UniverseSnapshot *inSnapshot,
+                                                        const QSharedPointer<SnapshotRecycler> & inRecycler);
+
+private:
+    QMutex m_mutex;
+    UniverseSnapshot *m_spare;
+};
+
+#endif // UNIVERSESNAPSHOT_H
@@ -5,6 +5,7 @@
 
 
 #include "universeview.h"
+#include <tracerecorder.h>
 #include <math.h>
 #include <QMouseEvent>
 #include <QDebug>
@@ -21,6 +22,10 @@ UniverseView::UniverseView(QWidget *inParent) :
     m_ShipVisitedPathItem->hide();
     m_ShipUnvisitedPathItem = new GraphicsPathItem();
     m_ShipUnvisitedPathItem->hide();
+    // isles are background, see UniverseScene
+    setCacheMode(QGraphicsView::CacheBackground);
+    // ships report small dirty rects, merge them only if there are too many
+    setViewportUpdateMode(QGraphicsView::SmartViewportUpdate);
 }
 
 
@@ -164,6 +169,13 @@ void UniverseView::mousePressEvent(QMouseEvent *inMouseEvent)
 }
 
 
+void UniverseView::paintEvent(QPaintEvent *inPaintEvent)
+{
+    WW_TRACE_SPAN("UniverseView::paintEvent");
+    QGraphicsView::paintEvent(inPaintEvent);
+}
+
+
 void UniverseView::mouseMoveEvent(QMouseEvent *inMouseEvent)
 {
     if(! (m_shipWantsTarget or m_isleWantsDefaultTarget))
@@ -52,6 +52,9 @@ private:
     // shows the rubber band. Is only activem when toggleSomethingWantsTaget() activates mouse tracking
     void mouseMoveEvent(QMouseEvent *inMouseEvent);
 
+    // just QGraphicsView::paintEvent(), but traced
+    void paintEvent(QPaintEvent *inPaintEvent);
+
     // Path for Isle (default target), Ships (list of targets)
     GraphicsPathItem *m_islePathItem;
     GraphicsPathItem *m_ShipVisitedPathItem;
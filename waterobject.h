@@ -9,20 +9,21 @@
 
 
 #include <QPoint>
-#include <QColor>
 
 
 class WaterObject
 {
 public:
     explicit WaterObject(const uint inId, const uint inOwner, const QPointF inPos,
-                         const QColor inColor, const float inTechnology);
+                         const float inTechnology);
 
     ~WaterObject() {}
 
     // getter
     uint id() const { return m_id; }
 
+    uint owner() const { return m_owner; }
+
     QPointF pos() const { return m_pos; }
 
     // Force: subclass must implement these method
@@ -35,7 +36,6 @@ protected:
     uint m_id;
     uint m_owner;
     QPointF m_pos;
-    QColor m_color;
     float m_technology;
 };
 
@@ -7,7 +7,7 @@
 #include <waterobjectinfo.h>
 #include <pathlistitem.h>
 #include <shiplistitem.h>
-#include <player.h>
+#include <playercolor.h>
 
 #include <QTableWidget>
 #include <QPalette>
@@ -85,7 +85,7 @@ void WaterObjectInfo::showInfopageIsle(const IsleInfo inIsleInfo)
 
     // prepare page
     QPixmap pix(30, 20);
-    pix.fill(inIsleInfo.color);
+    pix.fill(PlayerColor::colorForOwner(inIsleInfo.owner));
     m_ui->labelIsleId->setText(QString("%1").arg(inIsleInfo.id));
     m_ui->labelIsleColor->setPixmap(pix);
 
@@ -107,7 +107,7 @@ void WaterObjectInfo::showInfopageHumanIsle(const IsleInfo inIsleInfo, const QLi
 
     // prepare page
     QPixmap pix(30, 20);
-    pix.fill(inIsleInfo.color);
+    pix.fill(PlayerColor::colorForOwner(inIsleInfo.owner));
     m_ui->labelHumanIsleId->setText(QString("%1").arg(inIsleInfo.id));
     m_ui->labelHumanIsleId->setProperty("ISLEID", QVariant(inIsleInfo.id));
     m_ui->labelHumanIsleColor->setPixmap(pix);
@@ -185,7 +185,7 @@ void WaterObjectInfo::showInfopageShip(const ShipInfo inShipInfo)
 
     // prepare page
     QPixmap pix(30, 20);
-    pix.fill(inShipInfo.color);
+    pix.fill(PlayerColor::colorForOwner(inShipInfo.owner));
 
     m_ui->labelShipId->setText(QString("%1").arg(inShipInfo.id));
     m_ui->labelShipColor->setPixmap(pix);
@@ -212,7 +212,7 @@ void WaterObjectInfo::showInfopageHumanShip(const ShipInfo inShipInfo, const QVe
 
     // prepare page
     QPixmap pix(30, 20);
-    pix.fill(inShipInfo.color);
+    pix.fill(PlayerColor::colorForOwner(inShipInfo.owner));
     m_ui->labelHumanShipId->setText(QString("%1").arg(inShipInfo.id));
     m_ui->labelHumanShipColor->setPixmap(pix);
     QString s = QString("Damage: %1%").arg(inShipInfo.damage * 100.0f, 3, 'F', 0);
@@ -269,7 +269,7 @@ void WaterObjectInfo::showInfopageHumanShip(const ShipInfo inShipInfo, const QVe
 
         // owner of target
         uint owner = t.target_owner;
-        QColor color = Player::colorForOwner(owner);
+        QColor color = PlayerColor::colorForOwner(owner);
 
         PathListItem *item2 = new PathListItem(PathListItem::PLIT_OWNER, i, uTimeToTarget, t.target, owner, color);
         m_ui->tableHTargets->setItem(i, 1, item2);
@@ -10,6 +10,7 @@
 
 #include <isle.h>
 #include <ship.h>
+#include <infoscreenpage.h>
 #include "ui_waterobjectinfo.h"
 
 #include <QStackedWidget>
@@ -21,9 +22,6 @@ namespace Ui {
 }
 
 
-enum InfoscreenPageEnum {PAGE_NOTHING = 0, PAGE_WATER = 1, PAGE_ISLE = 2, PAGE_HUMAN_ISLE = 3, PAGE_SHIP = 4, PAGE_HUMAN_SHIP = 5};
-
-
 /* Extended Target is a Target which knows the owner of the target.
  * We need it here, because we want to draw the owner color of a target.
  * For objects except isles or ships, the target_owner is 0 */
@@ -0,0 +1,49 @@
+#-------------------------------------------------
+#
+# WaterWorld GUI, uses the simulation from waterworld_core
+#
+#-------------------------------------------------
+
+QT       += core gui
+
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+
+TARGET = WaterWorld
+TEMPLATE = app
+
+CONFIG += console
+CONFIG += c++11
+
+include(waterworld_core.pri)
+
+
+SOURCES += main.cpp\
+        mainwindow.cpp \
+    universescene.cpp \
+    minimapview.cpp \
+    universeview.cpp \
+    universerenderer.cpp \
+    shipbatchitem.cpp \
+    shiplistitem.cpp \
+    overviewdialog.cpp \
+    graphicspathitem.cpp \
+    pathlistitem.cpp \
+    playercolor.cpp \
+    waterobjectinfo.cpp
+
+HEADERS  += mainwindow.h \
+    universescene.h \
+    minimapview.h \
+    universeview.h \
+    universerenderer.h \
+    shipbatchitem.h \
+    shiplistitem.h \
+    overviewdialog.h \
+    graphicspathitem.h \
+    pathlistitem.h \
+    playercolor.h \
+    waterobjectinfo.h
+
+FORMS    += mainwindow.ui \
+    waterobjectinfo.ui \
+    overviewdialog.ui
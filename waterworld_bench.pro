@@ -0,0 +1,22 @@
+#-------------------------------------------------
+#
+# Turn-time benchmark for the simulation core,
+# prints a JSON report. See bench.cpp.
+#
+#-------------------------------------------------
+
+QT       = core
+
+TARGET = waterworld_bench
+TEMPLATE = app
+
+CONFIG += console
+CONFIG -= app_bundle
+CONFIG += c++11
+
+include(waterworld_core.pri)
+
+win32: LIBS += -lpsapi
+
+
+SOURCES += bench.cpp
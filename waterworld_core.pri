@@ -0,0 +1,18 @@
+# include this in every project, which links against waterworld_core
+
+INCLUDEPATH += $$PWD
+DEPENDPATH += $$PWD
+
+win32 {
+    CONFIG(debug, debug|release): WATERWORLD_CORE_DIR = $$OUT_PWD/debug
+    else: WATERWORLD_CORE_DIR = $$OUT_PWD/release
+    PRE_TARGETDEPS += $$WATERWORLD_CORE_DIR/waterworld_core.lib
+} else {
+    WATERWORLD_CORE_DIR = $$OUT_PWD
+    PRE_TARGETDEPS += $$WATERWORLD_CORE_DIR/libwaterworld_core.a
+}
+
+LIBS += -L$$WATERWORLD_CORE_DIR -lwaterworld_core
+
+# keep the trace spans of the consumer in line with the core, see waterworld_core.pro
+notrace: DEFINES += WATERWORLD_NO_TRACE
@@ -0,0 +1,80 @@
+#-------------------------------------------------
+#
+# Simulation core of WaterWorld. No QtGui, no QtWidgets,
+# so this runs without any display.
+#
+#-------------------------------------------------
+
+QT       = core
+
+TARGET = waterworld_core
+TEMPLATE = lib
+
+CONFIG += staticlib
+CONFIG += c++11
+
+# ShipKinematics moves ships with SSE2 on x86-64 and plain C++ elsewhere.
+# Run "qmake CONFIG+=avx" to use AVX instead.
+avx {
+    gcc|clang: QMAKE_CXXFLAGS += -mavx
+    msvc: QMAKE_CXXFLAGS += /arch:AVX
+}
+
+# Universe::nextRound() measures its phases and counts events, see RoundProfile.
+# Run "qmake CONFIG+=noprofile" to compile that out.
+noprofile: DEFINES += WATERWORLD_NO_PROFILE
+
+# Categories of the EventLog, which are compiled in. Run e.g.
+# "qmake WATERWORLD_EVENTLOG_CATEGORIES=0" to compile out every event.
+!isEmpty(WATERWORLD_EVENTLOG_CATEGORIES): DEFINES += WATERWORLD_EVENTLOG_CATEGORIES=$$WATERWORLD_EVENTLOG_CATEGORIES
+
+# Spans for "WaterWorld --trace", see TraceRecorder. Run "qmake CONFIG+=notrace" to compile them out.
+notrace: DEFINES += WATERWORLD_NO_TRACE
+
+
+SOURCES += universe.cpp \
+    waterobject.cpp \
+    isle.cpp \
+    ship.cpp \
+    computerplayer.cpp \
+    player.cpp \
+    objectindex.cpp \
+    garrisonlist.cpp \
+    pursuerindex.cpp \
+    spatialgrid.cpp \
+    worldindex.cpp \
+    changefeed.cpp \
+    shippool.cpp \
+    random.cpp \
+    roundprofile.cpp \
+    eventlog.cpp \
+    tracerecorder.cpp \
+    universesnapshot.cpp \
+    shipkinematics.cpp \
+    commandqueue.cpp \
+    playerstats.cpp \
+    statsrecorder.cpp
+
+HEADERS  += universe.h \
+    waterobject.h \
+    isle.h \
+    ship.h \
+    computerplayer.h \
+    player.h \
+    infoscreenpage.h \
+    objectindex.h \
+    garrisonlist.h \
+    pursuerindex.h \
+    spatialgrid.h \
+    worldindex.h \
+    changefeed.h \
+    shippool.h \
+    random.h \
+    roundprofile.h \
+    eventlog.h \
+    tracerecorder.h \
+    universesnapshot.h \
+    shipkinematics.h \
+    commandqueue.h \
+    playerstats.h \
+    statsrecorder.h
@@ -0,0 +1,20 @@
+#-------------------------------------------------
+#
+# Decoder for the binary event log of the
+# simulation core. See eventlogdump.cpp.
+#
+#-------------------------------------------------
+
+QT       = core
+
+TARGET = waterworld_eventlog
+TEMPLATE = app
+
+CONFIG += console
+CONFIG -= app_bundle
+CONFIG += c++11
+
+include(waterworld_core.pri)
+
+
+SOURCES += eventlogdump.cpp
@@ -0,0 +1,20 @@
+#-------------------------------------------------
+#
+# Converts the binary per round statistics of the
+# simulation core to CSV. See statsdump.cpp.
+#
+#-------------------------------------------------
+
+QT       = core
+
+TARGET = waterworld_stats
+TEMPLATE = app
+
+CONFIG += console
+CONFIG -= app_bundle
+CONFIG += c++11
+
+include(waterworld_core.pri)
+
+
+SOURCES += statsdump.cpp
@@ -0,0 +1,32 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+#include <worldindex.h>
+#include <ship.h>
+#include <objectindex.h>
+
+
+WorldIndex::WorldIndex(const qreal inUniverseWidth, const qreal inUniverseHeight)
+    : shipGrid(inUniverseWidth, inUniverseHeight, 2.0f * Ship::HALF_WIDTH),
+      m_isles(0), m_isleIndex(0)
+{
+}
+
+
+void WorldIndex::setIsles(const QVector<Isle*> *inIsles, const ObjectIndex *inIsleIndex)
+{
+    m_isles = inIsles;
+    m_isleIndex = inIsleIndex;
+}
+
+
+Isle* WorldIndex::isle(const uint inIsleId) const
+{
+    if(m_isles == 0 or inIsleId == 0)
+        return 0;
+    int slot = m_isleIndex->slot(inIsleId);
+    return slot >= 0 ? m_isles->at(slot) : 0;
+}
@@ -0,0 +1,59 @@
+/* This File is part of WaterWorld. License is GNU GPL Version 3.
+ * Please see https://github.com/ngc42/WaterWorld/blob/master/LICENSE for details.
+ * WaterWorld is (C) 2016 by Eike Lange (eike@ngc42.de)
+ */
+
+
+#ifndef WORLDINDEX_H
+#define WORLDINDEX_H
+
+
+#include <pursuerindex.h>
+#include <spatialgrid.h>
+#include <shipkinematics.h>
+#include <changefeed.h>
+#include <playerstats.h>
+#include <QVector>
+
+
+class Isle;
+class ObjectIndex;
+
+
+/**
+ * @brief The WorldIndex class collects the indexes, which ships and isles keep up to date by themselves
+ *
+ * Universe owns one WorldIndex and hands it over to every ship and isle it creates.
+ */
+class WorldIndex
+{
+public:
+    WorldIndex(const qreal inUniverseWidth, const qreal inUniverseHeight);
+
+    // isles are owned by Universe, we only look them up
+    void setIsles(const QVector<Isle*> *inIsles, const ObjectIndex *inIsleIndex);
+
+    // isle with that id or 0
+    Isle* isle(const uint inIsleId) const;
+
+    // target ship id -> ships, which have this target
+    PursuerIndex pursuers;
+
+    // position of every ship
+    SpatialGrid shipGrid;
+
+    // position, target and speed of sailing ships
+    ShipKinematics kinematics;
+
+    // which isles and ships changed during the round, for the computer players
+    ChangeFeed changes;
+
+    // isles, population, ships and force per owner
+    PlayerStats stats;
+
+private:
+    const QVector<Isle*> *m_isles;
+    const ObjectIndex *m_isleIndex;
+};
+
+#endif // WORLDINDEX_H